@@ -0,0 +1,215 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "LazyWidgetTelemetry.h"
+#include "LazyWidget.h"
+#include "MenuWidget.h"
+#include "SlateUtils.h"
+#include "StatsUIAdditionsPlugin.h"
+#include "LogUIAdditionsPlugin.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+
+static TAutoConsoleVariable<bool> CVarLazyWidgetTelemetry(
+	TEXT("UIAdditionsPlugin.LazyWidget.Telemetry"),
+	false,
+	TEXT("Record the timings of the latest content loads by lazy widgets."),
+	ECVF_Default
+);
+
+static FAutoConsoleCommand CCmdLazyWidgetExportTelemetry(
+	TEXT("UIAdditionsPlugin.LazyWidget.ExportTelemetry"),
+	TEXT("Exports the lazy widget load records of this session to CSV. Optional argument: file path."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs) {
+		const FLazyWidgetTelemetry& Telemetry = FLazyWidgetTelemetry::Get();
+		Telemetry.ExportCSV(InArgs.Num() > 0 ? InArgs[0] : Telemetry.GetDefaultExportFilePath());
+	})
+);
+
+static FAutoConsoleCommand CCmdLazyWidgetResetTelemetry(
+	TEXT("UIAdditionsPlugin.LazyWidget.ResetTelemetry"),
+	TEXT("Clears the lazy widget load records and resets the lazy load counters."),
+	FConsoleCommandDelegate::CreateLambda([]() {
+		FLazyWidgetTelemetry::Get().Reset();
+	})
+);
+
+/* Quotes a CSV field if it contains a separator, quote or line break. Embedded quotes are doubled. */
+static FString EscapeCSVField(const FString& InField) {
+	int32 Index = INDEX_NONE;
+	if (!InField.FindChar(TEXT(','), Index) && !InField.FindChar(TEXT('"'), Index) && !InField.FindChar(TEXT('\n'), Index) && !InField.FindChar(TEXT('\r'), Index)) {
+		return InField;
+	}
+	return TEXT("\"") + InField.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+}
+
+
+// Setup
+
+FLazyWidgetTelemetry::FLazyWidgetTelemetry() {
+	SessionStartTime = FDateTime::Now();
+	SyncLoadPackageHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddRaw(this, &FLazyWidgetTelemetry::ActOnSyncLoadPackage);
+}
+
+FLazyWidgetTelemetry::~FLazyWidgetTelemetry() {
+	// Destroyed when the module is unloaded, which can happen before exit.
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadPackageHandle);
+}
+
+FLazyWidgetTelemetry& FLazyWidgetTelemetry::Get() {
+	static FLazyWidgetTelemetry Telemetry;
+	return Telemetry;
+}
+
+void FLazyWidgetTelemetry::ActOnSyncLoadPackage(const FString& InPackageName) {
+	if (IsInGameThread()) {
+		SyncLoadCounter++;
+	}
+}
+
+FLazyWidgetLoadRecord* FLazyWidgetTelemetry::FindRecord(int32 InRecordId) {
+	if (InRecordId < 0) {
+		return nullptr;
+	}
+	const int32 Slot = InRecordId % MaxRecords;
+	return (Records.IsValidIndex(Slot) && Records[Slot].Id == InRecordId) ? &Records[Slot] : nullptr;
+}
+
+// Records
+
+int32 FLazyWidgetTelemetry::BeginLoad(const ULazyWidget* InLazyWidget, bool bInAsync) {
+	INC_DWORD_STAT(STAT_LazyWidget_LoadsRequested);
+
+	if (!CVarLazyWidgetTelemetry.GetValueOnGameThread() || !IsValid(InLazyWidget)) {
+		return INDEX_NONE;
+	}
+
+	FLazyWidgetLoadRecord Record;
+	Record.LazyWidget = InLazyWidget->GetPathName();
+	const UMenuWidget* Menu = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(InLazyWidget);
+	Record.Menu = IsValid(Menu) ? Menu->GetClass()->GetName() : FString();
+	Record.Content = InLazyWidget->GetLazyContent().ToString();
+	Record.bAsync = bInAsync;
+	Record.RequestTime = FPlatformTime::Seconds();
+	Record.Id = NextRecordId;
+	// Wraps to 0 instead of overflowing, ids only have to be unique within the ring buffer.
+	NextRecordId = (NextRecordId == MAX_int32) ? 0 : NextRecordId + 1;
+
+	const int32 Slot = Record.Id % MaxRecords;
+	if (Records.IsValidIndex(Slot)) {
+		Records[Slot] = MoveTemp(Record);
+	}
+	else {
+		Records.Add(MoveTemp(Record));
+	}
+	return Records[Slot].Id;
+}
+
+void FLazyWidgetTelemetry::MarkLoaded(int32 InRecordIndex) {
+	FLazyWidgetLoadRecord* RecordPtr = FindRecord(InRecordIndex);
+	if (!RecordPtr) {
+		return;
+	}
+	FLazyWidgetLoadRecord& Record = *RecordPtr;
+	Record.LoadedTime = FPlatformTime::Seconds();
+
+	SET_FLOAT_STAT(STAT_LazyWidget_RequestToLoadedMs, (float)((Record.LoadedTime - Record.RequestTime) * 1000.0));
+}
+
+void FLazyWidgetTelemetry::MarkConstructed(int32 InRecordIndex, double InCreateWidgetSeconds, int32 InSyncLoads) {
+	INC_DWORD_STAT(STAT_LazyWidget_LoadsConstructed);
+	INC_DWORD_STAT_BY(STAT_LazyWidget_SyncLoads, InSyncLoads);
+
+	FLazyWidgetLoadRecord* RecordPtr = FindRecord(InRecordIndex);
+	if (!RecordPtr) {
+		return;
+	}
+	FLazyWidgetLoadRecord& Record = *RecordPtr;
+	Record.ConstructedTime = FPlatformTime::Seconds();
+	Record.CreateWidgetSeconds = InCreateWidgetSeconds;
+	Record.SyncLoads += InSyncLoads;
+
+	if (InSyncLoads > 0) {
+		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("%s: %d synchronous loads while loading lazy content %s."), *Record.LazyWidget, InSyncLoads, *Record.Content);
+	}
+
+	if (Record.LoadedTime > 0) {
+		SET_FLOAT_STAT(STAT_LazyWidget_LoadedToConstructedMs, (float)((Record.ConstructedTime - Record.LoadedTime) * 1000.0));
+	}
+}
+
+void FLazyWidgetTelemetry::MarkCancelled(int32 InRecordIndex) {
+	INC_DWORD_STAT(STAT_LazyWidget_LoadsCancelled);
+
+	FLazyWidgetLoadRecord* Record = FindRecord(InRecordIndex);
+	if (Record) {
+		Record->bCancelled = true;
+	}
+}
+
+int32 FLazyWidgetTelemetry::GetSyncLoadCounter() const {
+	return SyncLoadCounter;
+}
+
+TArray<FLazyWidgetLoadRecord> FLazyWidgetTelemetry::GetRecords() const {
+	if (Records.Num() < MaxRecords) {
+		return Records;
+	}
+	// Full, the oldest record is the one to be overwritten next.
+	TArray<FLazyWidgetLoadRecord> OrderedRecords;
+	OrderedRecords.Reserve(Records.Num());
+	const int32 OldestSlot = NextRecordId % MaxRecords;
+	for (int32 i = 0; i < Records.Num(); i++) {
+		OrderedRecords.Add(Records[(OldestSlot + i) % MaxRecords]);
+	}
+	return OrderedRecords;
+}
+
+void FLazyWidgetTelemetry::Reset() {
+	// Ids keep counting, so records of loads in progress are not found again.
+	Records.Reset();
+	SET_DWORD_STAT(STAT_LazyWidget_LoadsRequested, 0);
+	SET_DWORD_STAT(STAT_LazyWidget_LoadsConstructed, 0);
+	SET_DWORD_STAT(STAT_LazyWidget_LoadsCancelled, 0);
+	SET_DWORD_STAT(STAT_LazyWidget_SyncLoads, 0);
+	SET_FLOAT_STAT(STAT_LazyWidget_RequestToLoadedMs, 0.f);
+	SET_FLOAT_STAT(STAT_LazyWidget_LoadedToConstructedMs, 0.f);
+}
+
+// Export
+
+FString FLazyWidgetTelemetry::GetDefaultExportFilePath() const {
+	return FPaths::ProfilingDir() / TEXT("UIAdditionsPlugin") / FString::Printf(TEXT("LazyWidgetTelemetry-%s.csv"), *SessionStartTime.ToString());
+}
+
+bool FLazyWidgetTelemetry::ExportCSV(const FString& InFilePath) const {
+	// Stages which were not reached are exported as -1.
+	auto ToMs = [](double InFrom, double InTo) {
+		return (InFrom > 0 && InTo > 0) ? (InTo - InFrom) * 1000.0 : -1.0;
+	};
+
+	FString Csv = TEXT("LazyWidget,Menu,Content,Async,RequestToLoadedMs,LoadedToConstructedMs,CreateWidgetMs,SyncLoads,Cancelled\n");
+	const TArray<FLazyWidgetLoadRecord> OrderedRecords = GetRecords();
+	for (const FLazyWidgetLoadRecord& RecordX : OrderedRecords) {
+		Csv += FString::Printf(TEXT("%s,%s,%s,%d,%.3f,%.3f,%.3f,%d,%d\n")
+			, *EscapeCSVField(RecordX.LazyWidget)
+			, *EscapeCSVField(RecordX.Menu)
+			, *EscapeCSVField(RecordX.Content)
+			, RecordX.bAsync ? 1 : 0
+			, ToMs(RecordX.RequestTime, RecordX.LoadedTime)
+			, ToMs(RecordX.LoadedTime, RecordX.ConstructedTime)
+			, RecordX.ConstructedTime > 0 ? RecordX.CreateWidgetSeconds * 1000.0 : -1.0
+			, RecordX.SyncLoads
+			, RecordX.bCancelled ? 1 : 0
+		);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *InFilePath)) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Failed to export lazy widget telemetry to %s."), *InFilePath);
+		return false;
+	}
+
+	UE_LOG(LogUIAdditionsPlugin, Log, TEXT("Exported %d lazy widget load records to %s."), OrderedRecords.Num(), *InFilePath);
+	return true;
+}
@@ -0,0 +1,52 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "StatsUIAdditionsPlugin.h"
+
+
+// Lazy
+
+DEFINE_STAT(STAT_LazyWidget_CreateWidget);
+DEFINE_STAT(STAT_LazyWidget_LoadsRequested);
+DEFINE_STAT(STAT_LazyWidget_LoadsConstructed);
+DEFINE_STAT(STAT_LazyWidget_LoadsCancelled);
+DEFINE_STAT(STAT_LazyWidget_SyncLoads);
+DEFINE_STAT(STAT_LazyWidget_RequestToLoadedMs);
+DEFINE_STAT(STAT_LazyWidget_LoadedToConstructedMs);
+
+// Defer Paint
+
+DEFINE_STAT(STAT_DeferPaint_Groups);
+DEFINE_STAT(STAT_DeferPaint_Painted);
+DEFINE_STAT(STAT_DeferPaint_Culled);
+
+// Cursor
+
+DEFINE_STAT(STAT_AnalogCursor_HitIndexRebuild);
+DEFINE_STAT(STAT_AnalogCursor_HitIndexLayoutCheck);
+DEFINE_STAT(STAT_AnalogCursor_HitIndexEntries);
+
+// World Cursor
+
+DEFINE_STAT(STAT_WorldCursorTrace_Tick);
+DEFINE_STAT(STAT_WorldCursorTrace_Traces);
+DEFINE_STAT(STAT_WorldCursorTrace_Cached);
+
+// Menu
+
+DEFINE_STAT(STAT_MenuFocusPath_Resolve);
+DEFINE_STAT(STAT_MenuFocusPath_Cached);
+DEFINE_STAT(STAT_Menu_ContextRegistrations);
+DEFINE_STAT(STAT_Menu_AncestorWalks);
+
+// HUD
+
+DEFINE_STAT(STAT_HUDStartup_LoadMs);
+DEFINE_STAT(STAT_HUDStartup_ConstructMs);
+DEFINE_STAT(STAT_HUDStartup_AttachMs);
+DEFINE_STAT(STAT_HUDStartup_TotalMs);
+DEFINE_STAT(STAT_HUDCore_Tick);
+DEFINE_STAT(STAT_HUDCore_Ticks);
+
+// Focus
+
+DEFINE_STAT(STAT_FocusDispatcher_Events);
+DEFINE_STAT(STAT_FocusDispatcher_ListenersNotified);
@@ -0,0 +1,92 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MultiUserFocusChangeDispatcher.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Layout/WidgetPath.h"
+#include "Input/Events.h"
+#include "LogUIAdditionsPlugin.h"
+#include "StatsUIAdditionsPlugin.h"
+
+
+// Setup
+
+FMultiUserFocusChangeDispatcher::~FMultiUserFocusChangeDispatcher() {
+	Unsubscribe();
+}
+
+void FMultiUserFocusChangeDispatcher::Subscribe() {
+	if (FocusChangingHandle.IsValid() || !FSlateApplication::IsInitialized()) {
+		return;
+	}
+	FocusChangingHandle = FSlateApplication::Get().OnFocusChanging().AddRaw(this, &FMultiUserFocusChangeDispatcher::ActOnFocusChanging);
+}
+
+void FMultiUserFocusChangeDispatcher::Unsubscribe() {
+	if (!FocusChangingHandle.IsValid()) {
+		return;
+	}
+	if (FSlateApplication::IsInitialized()) {
+		FSlateApplication::Get().OnFocusChanging().Remove(FocusChangingHandle);
+	}
+	FocusChangingHandle.Reset();
+}
+
+// Listeners
+
+FDelegateHandle FMultiUserFocusChangeDispatcher::AddListener(int32 InUserIndex, const FOnUserFocusChanging& InDelegate) {
+	if (InUserIndex < 0) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Can not add a focus change listener without a valid user index."));
+		return FDelegateHandle();
+	}
+	if (!Listeners.IsValidIndex(InUserIndex)) {
+		Listeners.SetNum(InUserIndex + 1);
+	}
+
+	FListener Listener;
+	Listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Listener.Delegate = InDelegate;
+	Listeners[InUserIndex].Add(Listener);
+	NumListeners++;
+
+	Subscribe();
+	return Listener.Handle;
+}
+
+void FMultiUserFocusChangeDispatcher::RemoveListener(int32 InUserIndex, FDelegateHandle InHandle) {
+	if (!Listeners.IsValidIndex(InUserIndex) || !InHandle.IsValid()) {
+		return;
+	}
+	const int32 NumRemoved = Listeners[InUserIndex].RemoveAll([&InHandle](const FListener& InListenerX) {
+		return InListenerX.Handle == InHandle;
+	});
+	NumListeners -= NumRemoved;
+
+	// Keep the array dense up to the highest user with a listener.
+	while (Listeners.Num() > 0 && Listeners.Last().Num() == 0) {
+		Listeners.Pop(EAllowShrinking::No);
+	}
+	if (NumListeners == 0) {
+		Unsubscribe();
+	}
+}
+
+int32 FMultiUserFocusChangeDispatcher::GetNumListeners(int32 InUserIndex) const {
+	return Listeners.IsValidIndex(InUserIndex) ? Listeners[InUserIndex].Num() : 0;
+}
+
+// Delegates
+
+void FMultiUserFocusChangeDispatcher::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWidgetPath& InOldFocusedWidgetPath, const TSharedPtr<SWidget>& InOldFocusedWidget, const FWidgetPath& InNewFocusedWidgetPath, const TSharedPtr<SWidget>& InNewFocusedWidget) {
+	INC_DWORD_STAT(STAT_FocusDispatcher_Events);
+
+	const int32 UserIndex = (int32)InFocusEvent.GetUser();
+	if (!Listeners.IsValidIndex(UserIndex) || Listeners[UserIndex].Num() == 0) {
+		return;
+	}
+
+	// Copied, a listener can cause listeners to be added or removed, for example by restoring focus.
+	const TArray<FListener, TInlineAllocator<2>> UserListeners = Listeners[UserIndex];
+	for (const FListener& ListenerX : UserListeners) {
+		INC_DWORD_STAT(STAT_FocusDispatcher_ListenersNotified);
+		ListenerX.Delegate.ExecuteIfBound(InFocusEvent, InOldFocusedWidgetPath, InOldFocusedWidget, InNewFocusedWidgetPath, InNewFocusedWidget);
+	}
+}
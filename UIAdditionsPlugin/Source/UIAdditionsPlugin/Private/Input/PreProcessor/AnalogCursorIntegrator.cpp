@@ -0,0 +1,112 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "AnalogCursorIntegrator.h"
+
+
+void FAnalogCursorIntegrator::SetParameters(AnalogCursorMode::Type InMode, float InAcceleration, float InMaxSpeed) {
+	Mode = InMode;
+	Acceleration = InAcceleration;
+	MaxSpeed = InMaxSpeed;
+}
+
+float FAnalogCursorIntegrator::GetStepRate() const {
+	return StepRate;
+}
+
+void FAnalogCursorIntegrator::SetStepRate(float InStepRate) {
+	StepRate = FMath::Max(InStepRate, 1.f);
+}
+
+void FAnalogCursorIntegrator::AddSample(double InTime, const FVector2D& InValue) {
+	// Samples usually arrive in order, insert from the back.
+	int32 Index = Samples.Num();
+	while (Index > 0 && Samples[Index - 1].Time > InTime) {
+		Index--;
+	}
+	Samples.Insert(FAnalogCursorSample{ InTime, InValue }, Index);
+}
+
+FVector2D FAnalogCursorIntegrator::Advance(double InTime, float InSpeedMultiplier) {
+	if (!bHasSimulatedTime) {
+		SyncTime(InTime);
+		return FVector2D::ZeroVector;
+	}
+	if (InTime - SimulatedTime > MaxCatchUpTime) {
+		SimulatedTime = InTime - MaxCatchUpTime;
+	}
+
+	const double StepTime = 1.0 / StepRate;
+	FVector2D Displacement = FVector2D::ZeroVector;
+	int32 NumConsumed = 0;
+
+	while (SimulatedTime + StepTime <= InTime) {
+		// Apply every sample received up to the start of this step.
+		while (NumConsumed < Samples.Num() && Samples[NumConsumed].Time <= SimulatedTime) {
+			Input = Samples[NumConsumed].Value;
+			NumConsumed++;
+		}
+		Displacement += Step(StepTime);
+		SimulatedTime += StepTime;
+	}
+
+	if (NumConsumed > 0) {
+		Samples.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+	}
+	return Displacement * InSpeedMultiplier;
+}
+
+FVector2D FAnalogCursorIntegrator::Step(float InStepTime) {
+	switch (Mode) {
+	case (AnalogCursorMode::Accelerated): {
+		// Clamp per axis between 0 and the input scaled max speed, this gives instant direction change when crossing the axis.
+		const double MinSpeedX = FMath::Min(Input.X * MaxSpeed, 0.0);
+		const double MaxSpeedX = FMath::Max(Input.X * MaxSpeed, 0.0);
+		const double MinSpeedY = FMath::Min(Input.Y * MaxSpeed, 0.0);
+		const double MaxSpeedY = FMath::Max(Input.Y * MaxSpeed, 0.0);
+
+		// Cubic acceleration curve, matching FExtendedAnalogCursor::Tick.
+		const FVector2D ExpAcceleration = Input * Input * Input * Acceleration;
+		Speed += ExpAcceleration * InStepTime;
+		Speed.X = FMath::Clamp(Speed.X, MinSpeedX, MaxSpeedX);
+		Speed.Y = FMath::Clamp(Speed.Y, MinSpeedY, MaxSpeedY);
+		break;
+	}
+	case (AnalogCursorMode::Direct):
+		Speed = Input * MaxSpeed;
+		break;
+	}
+	return Speed * InStepTime;
+}
+
+void FAnalogCursorIntegrator::SyncTime(double InTime) {
+	SimulatedTime = InTime;
+	bHasSimulatedTime = true;
+	// Samples up to now are no longer in the future, keep only the latest value.
+	int32 NumConsumed = 0;
+	while (NumConsumed < Samples.Num() && Samples[NumConsumed].Time <= InTime) {
+		Input = Samples[NumConsumed].Value;
+		NumConsumed++;
+	}
+	if (NumConsumed > 0) {
+		Samples.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+	}
+}
+
+void FAnalogCursorIntegrator::Reset(double InTime, const FVector2D& InSpeed) {
+	Samples.Reset();
+	Input = FVector2D::ZeroVector;
+	Speed = InSpeed;
+	SimulatedTime = InTime;
+	bHasSimulatedTime = true;
+}
+
+const FVector2D& FAnalogCursorIntegrator::GetSpeed() const {
+	return Speed;
+}
+
+const FVector2D& FAnalogCursorIntegrator::GetInput() const {
+	return Input;
+}
+
+bool FAnalogCursorIntegrator::HasPendingSamples() const {
+	return Samples.Num() > 0;
+}
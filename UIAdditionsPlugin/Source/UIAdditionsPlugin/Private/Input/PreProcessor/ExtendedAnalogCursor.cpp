@@ -11,6 +11,8 @@
 #include "Framework/Application/SlateUser.h"
 #include "UnrealClient.h"
 #include "Layout/ArrangedChildren.h"
+#include "InteractableWidgetHitIndex.h"
+#include "HAL/PlatformTime.h"
 
 
 FExtendedAnalogCursor::FExtendedAnalogCursor(FLocalPlayerContext InLocalPlayerContext)
@@ -18,10 +20,13 @@ FExtendedAnalogCursor::FExtendedAnalogCursor(FLocalPlayerContext InLocalPlayerCo
 	LocalPlayerContext = InLocalPlayerContext;
 	SetStick(EAnalogStick::Right);
 	SetDeadZone(0.2f);
+
+	ClampGeometryCache.OnInvalidated.AddRaw(this, &FExtendedAnalogCursor::ActOnClampGeometryInvalidated);
 }
 
 int32 FExtendedAnalogCursor::GetOwnerUserIndex() const {
-	return (LocalPlayerContext.IsValid() ? LocalPlayerContext.GetLocalPlayer()->GetControllerId() : 0);
+	// INDEX_NONE rather than 0, an invalid context must not take over the first player's input.
+	return (LocalPlayerContext.IsValid() ? LocalPlayerContext.GetLocalPlayer()->GetControllerId() : INDEX_NONE);
 }
 
 bool FExtendedAnalogCursor::HandleKeyDownEvent(FSlateApplication& InSlateApp, const FKeyEvent& InKeyEvent) {
@@ -177,6 +182,11 @@ bool FExtendedAnalogCursor::HandleAnalogInputEvent(FSlateApplication& InSlateApp
 
 	// Call super to handle the event.
 	const bool bHandled = FAnalogCursor::HandleAnalogInputEvent(InSlateApp, InAnalogInputEvent);
+
+	if (GetUseFixedStepIntegration()) {
+		// Buffer the sample with its time of arrival, so input received between frames is applied at the right moment.
+		Integrator.AddSample(FPlatformTime::Seconds(), GetDeadZoneAdjustedAnalogValues());
+	}
 	//UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Slate User: %d, Analog: %s, State: Handled"), InAnalogInputEvent.GetUserIndex(), *InAnalogInputEvent.GetKey().ToString());
 	return bHandled;
 }
@@ -196,86 +206,118 @@ void FExtendedAnalogCursor::Tick(const float InDeltaTime, FSlateApplication& InS
 
 		ClearAnalogValues();
 
+		const UGameViewportClient* GameViewportClient = GetGameViewportClient();
+		ClampGeometryCache.Validate();
+		if (!bIsFreezeAnchorValid) {
+			FreezeAnchor = USlateUtils::GetCenterOfPlayerScreen(GameViewportClient, LocalPlayerContext.GetLocalPlayer());
+			bIsFreezeAnchorValid = true;
+		}
+		else if (bHasCurrentPosition && CurrentPosition.Equals(FreezeAnchor, 1.f) && SlateUser->GetCursorPosition().Equals(CurrentPosition, 1.f)) {
+			// Still pinned, no need to route another mouse event through Slate. CurrentPosition is truncated, so a fractional anchor is never matched exactly.
+			return;
+		}
+
 		// Update the Slate cursor position with the center position.
-		const FVector2D NewPosition = USlateUtils::GetCenterOfPlayerScreen(LocalPlayerContext.GetLocalPlayer());
-		UpdateCursorPosition(InSlateApp, SlateUser.ToSharedRef(), NewPosition, true);
+		UpdateCursorPosition(InSlateApp, SlateUser.ToSharedRef(), FreezeAnchor, true);
 
 		// No need to do anything beyond here while centering the cursor.
 		return;
 	}
 	else {
 		const FVector2D OldPosition = SlateUser->GetCursorPosition();
+		// Nothing else moved the cursor since we last placed it.
+		const bool bIsCursorUnchanged = bHasCurrentPosition && OldPosition == CurrentPosition;
 
-		float SpeedMult = 1.0f; // Used to do a speed multiplication before adding the delta to the position to make widgets sticky
-		FVector2D AdjAnalogVals = GetAnalogValues(AnalogStick); // A copy of the analog values so I can modify them based being over a widget
+		const double Now = FPlatformTime::Seconds();
 
-		// Adjust analog values according to dead zone
-		const float AnalogValsSize = AdjAnalogVals.Size();
+		float SpeedMult = 1.0f; // Used to do a speed multiplication before adding the delta to the position to make widgets sticky
+		const FVector2D AdjAnalogVals = GetDeadZoneAdjustedAnalogValues();
+
+		// Idle skip. No stick input beyond the dead zone, no remaining speed and nothing moved means there is nothing to do.
+		// Magnetism can still move an idle cursor, that case is skipped further down once it settles.
+		const bool bIsStickIdle = AdjAnalogVals.IsNearlyZero() && CurrentSpeed.IsNearlyZero() && !(GetUseFixedStepIntegration() && Integrator.HasPendingSamples());
+		if (bIsStickIdle && bIsCursorUnchanged && (GetMagnetismStrength() <= 0.f || !InteractableWidgetHitIndex.IsValid())) {
+			if (GetUseFixedStepIntegration()) {
+				// Don't simulate the idle time once input resumes.
+				Integrator.SyncTime(Now);
+			}
+			return;
+		}
 
-		if (AnalogValsSize > 0.0f) {
-			const float TargetSize = FMath::Max(AnalogValsSize - DeadZone, 0.0f) / (1.0f - DeadZone);
-			AdjAnalogVals /= AnalogValsSize;
-			AdjAnalogVals *= TargetSize;
+		if (InteractableWidgetHitIndex.IsValid()) {
+			InteractableWidgetHitIndex->ConditionalRebuild();
 		}
 
 		// Check if there is a sticky widget beneath the cursor
 		if (USlateUtils::GetCurrentInputDevice(SlateUser->GetUserIndex()) != EInputDevices::Mouse) {
-			FWidgetPath WidgetPath = InSlateApp.LocateWindowUnderMouse(OldPosition, InSlateApp.GetInteractiveTopLevelWindows(), false, SlateUser->GetUserIndex());
-			if (WidgetPath.IsValid()) {
-				const FArrangedChildren::FArrangedWidgetArray& AllArrangedWidgets = WidgetPath.Widgets.GetInternalArray();
-				for (const FArrangedWidget& ArrangedWidget : AllArrangedWidgets) {
-					const TSharedRef<SWidget> Widget = ArrangedWidget.Widget;
-					if (Widget->IsInteractable()) {
-						SpeedMult = StickySlowdown;
-						//FVector2D Adjustment = WidgetsAndCursors.Last().Geometry.Position - OldPosition; // example of calculating distance from cursor to widget center
-						break;
-					}
-				}
+			if (IsOverInteractableWidget(InSlateApp, SlateUser.ToSharedRef(), OldPosition)) {
+				SpeedMult = StickySlowdown;
 			}
 		}
 
-		float CurrentMinSpeedX = 0.0f;
-		float CurrentMaxSpeedX = 0.0f;
-		float CurrentMinSpeedY = 0.0f;
-		float CurrentMaxSpeedY = 0.0f;
-		FVector2D ExpAcceleration = FVector2D::ZeroVector;
-
-		switch (Mode) {
-		case (AnalogCursorMode::Accelerated):
-			// Generate Min and Max for X to clamp the speed, this gives us instant direction change when crossing the axis
-			if (AdjAnalogVals.X > 0.0f) {
-				CurrentMaxSpeedX = AdjAnalogVals.X * MaxSpeed;
-			}
-			else {
-				CurrentMinSpeedX = AdjAnalogVals.X * MaxSpeed;
-			}
+		if (GetUseFixedStepIntegration()) {
+			// Simulated at a fixed rate from the buffered samples, independent of InDeltaTime.
+			Integrator.SetParameters(Mode, Acceleration, MaxSpeed);
+			CurrentOffset += Integrator.Advance(Now, SpeedMult);
+			CurrentSpeed = Integrator.GetSpeed();
+		}
+		else {
+			float CurrentMinSpeedX = 0.0f;
+			float CurrentMaxSpeedX = 0.0f;
+			float CurrentMinSpeedY = 0.0f;
+			float CurrentMaxSpeedY = 0.0f;
+			FVector2D ExpAcceleration = FVector2D::ZeroVector;
+
+			switch (Mode) {
+			case (AnalogCursorMode::Accelerated):
+				// Generate Min and Max for X to clamp the speed, this gives us instant direction change when crossing the axis
+				if (AdjAnalogVals.X > 0.0f) {
+					CurrentMaxSpeedX = AdjAnalogVals.X * MaxSpeed;
+				}
+				else {
+					CurrentMinSpeedX = AdjAnalogVals.X * MaxSpeed;
+				}
 
-			// Generate Min and Max for Y to clamp the speed, this gives us instant direction change when crossing the axis
-			if (AdjAnalogVals.Y > 0.0f) {
-				CurrentMaxSpeedY = AdjAnalogVals.Y * MaxSpeed;
-			}
-			else {
-				CurrentMinSpeedY = AdjAnalogVals.Y * MaxSpeed;
+				// Generate Min and Max for Y to clamp the speed, this gives us instant direction change when crossing the axis
+				if (AdjAnalogVals.Y > 0.0f) {
+					CurrentMaxSpeedY = AdjAnalogVals.Y * MaxSpeed;
+				}
+				else {
+					CurrentMinSpeedY = AdjAnalogVals.Y * MaxSpeed;
+				}
+
+				// Cubic acceleration curve
+				ExpAcceleration = AdjAnalogVals * AdjAnalogVals * AdjAnalogVals * Acceleration;
+				// Preserve direction (if we use a squared equation above)
+				//ExpAcceleration.X *= FMath::Sign(AnalogValues.X);
+				//ExpAcceleration.Y *= FMath::Sign(AnalogValues.Y);
+
+				CurrentSpeed += ExpAcceleration * InDeltaTime;
+				CurrentSpeed.X = FMath::Clamp(CurrentSpeed.X, CurrentMinSpeedX, CurrentMaxSpeedX);
+				CurrentSpeed.Y = FMath::Clamp(CurrentSpeed.Y, CurrentMinSpeedY, CurrentMaxSpeedY);
+				break;
+			case (AnalogCursorMode::Direct):
+				CurrentSpeed = AdjAnalogVals * MaxSpeed;
+				break;
 			}
 
-			// Cubic acceleration curve
-			ExpAcceleration = AdjAnalogVals * AdjAnalogVals * AdjAnalogVals * Acceleration;
-			// Preserve direction (if we use a squared equation above)
-			//ExpAcceleration.X *= FMath::Sign(AnalogValues.X);
-			//ExpAcceleration.Y *= FMath::Sign(AnalogValues.Y);
-
-			CurrentSpeed += ExpAcceleration * InDeltaTime;
-			CurrentSpeed.X = FMath::Clamp(CurrentSpeed.X, CurrentMinSpeedX, CurrentMaxSpeedX);
-			CurrentSpeed.Y = FMath::Clamp(CurrentSpeed.Y, CurrentMinSpeedY, CurrentMaxSpeedY);
-			break;
-		case (AnalogCursorMode::Direct):
-			CurrentSpeed = AdjAnalogVals * MaxSpeed;
-			break;
+			CurrentOffset += CurrentSpeed * InDeltaTime * SpeedMult;
 		}
 
-		CurrentOffset += CurrentSpeed * InDeltaTime * SpeedMult;
+		// Pull the cursor towards the nearest interactable widget while the stick is idle.
+		if (InteractableWidgetHitIndex.IsValid() && GetMagnetismStrength() > 0.f && AdjAnalogVals.IsNearlyZero()) {
+			FVector2D Center = FVector2D::ZeroVector;
+			if (InteractableWidgetHitIndex->FindNearest(OldPosition, GetMagnetismRadius(), Center).IsValid()) {
+				CurrentOffset += (Center - OldPosition) * FMath::Min(GetMagnetismStrength() * InDeltaTime, 1.f);
+			}
+		}
 		const FVector2D NewPosition = OldPosition + CurrentOffset;
 
+		if (bIsStickIdle && bIsCursorUnchanged && FMath::FloorToInt32(NewPosition.X) == FMath::FloorToInt32(OldPosition.X) && FMath::FloorToInt32(NewPosition.Y) == FMath::FloorToInt32(OldPosition.Y)) {
+			// Settled, keep the sub-pixel offset for the next tick.
+			return;
+		}
+
 		// save the remaining sub-pixel offset 
 		CurrentOffset.X = FGenericPlatformMath::Frac(NewPosition.X);
 		CurrentOffset.Y = FGenericPlatformMath::Frac(NewPosition.Y);
@@ -285,6 +327,39 @@ void FExtendedAnalogCursor::Tick(const float InDeltaTime, FSlateApplication& InS
 	}
 }
 
+FVector2D FExtendedAnalogCursor::GetDeadZoneAdjustedAnalogValues() const {
+	FVector2D AdjAnalogVals = GetAnalogValues(AnalogStick); // A copy of the analog values so I can modify them based being over a widget
+
+	// Adjust analog values according to dead zone
+	const float AnalogValsSize = AdjAnalogVals.Size();
+
+	if (AnalogValsSize > 0.0f) {
+		const float TargetSize = FMath::Max(AnalogValsSize - DeadZone, 0.0f) / (1.0f - DeadZone);
+		AdjAnalogVals /= AnalogValsSize;
+		AdjAnalogVals *= TargetSize;
+	}
+	return AdjAnalogVals;
+}
+
+bool FExtendedAnalogCursor::IsOverInteractableWidget(FSlateApplication& InSlateApp, const TSharedRef<FSlateUser> InSlateUser, const FVector2D& InPosition) const {
+	if (InteractableWidgetHitIndex.IsValid()) {
+		return InteractableWidgetHitIndex->IsInteractableAtPosition(InPosition);
+	}
+
+	FWidgetPath WidgetPath = InSlateApp.LocateWindowUnderMouse(InPosition, InSlateApp.GetInteractiveTopLevelWindows(), false, InSlateUser->GetUserIndex());
+	if (WidgetPath.IsValid()) {
+		const FArrangedChildren::FArrangedWidgetArray& AllArrangedWidgets = WidgetPath.Widgets.GetInternalArray();
+		for (const FArrangedWidget& ArrangedWidget : AllArrangedWidgets) {
+			const TSharedRef<SWidget> Widget = ArrangedWidget.Widget;
+			if (Widget->IsInteractable()) {
+				//FVector2D Adjustment = WidgetsAndCursors.Last().Geometry.Position - OldPosition; // example of calculating distance from cursor to widget center
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 bool FExtendedAnalogCursor::IsRelevantCursorMovementKey(const FKey Key) const {
 	return AnalogStickKeys.Contains(Key);
 }
@@ -295,8 +370,7 @@ void FExtendedAnalogCursor::UpdateCursorPosition(FSlateApplication& InSlateApp,
 		return;
 	}
 
-	UWorld* World = GEngine->GetWorldFromContextObject(LocalPlayerContext.GetLocalPlayer(), EGetWorldErrorMode::LogAndReturnNull);
-	const UGameViewportClient* GameViewportClient = IsValid(World) ? World->GetGameViewport() : nullptr;
+	const UGameViewportClient* GameViewportClient = GetGameViewportClient();
 	if (!IsValid(GameViewportClient)) {
 		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("ExtendedAnalogCursor << invalid GameViewportClient."));
 		return;
@@ -321,10 +395,7 @@ void FExtendedAnalogCursor::UpdateCursorPosition(FSlateApplication& InSlateApp,
 	// Clamp the new position to within relevant space. 
 	// Setting things out of bounds (SetCursorPosition, SetPositionInViewport) seems to break things (such as tick on widget.).
 	// TODO check if this is enough for split screen so that we don't move onto another screen.
-	const FGeometry Geometry = (GetCursorScreenSpace() == E_CursorScreenSpace::PlayerScreen
-		? UWidgetLayoutLibrary::GetPlayerScreenWidgetGeometry(LocalPlayerContext.GetPlayerController())
-		: UWidgetLayoutLibrary::GetViewportWidgetGeometry(LocalPlayerContext.GetPlayerController())
-	);
+	const FGeometry& Geometry = GetClampGeometry();
 
 	const FVector2D ClampedNewPosition = USlateUtils::ClampAbsolutePositionToGeometry(Geometry, InNewPosition);
 	
@@ -381,6 +452,28 @@ void FExtendedAnalogCursor::UpdateCursorPosition(FSlateApplication& InSlateApp,
 	//UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Slate User: %d, Position: %s"), SlateUser->GetUserIndex(), *UpdatedPosition.ToString());
 	// Store for quick access
 	CurrentPosition = UpdatedPosition;
+	bHasCurrentPosition = true;
+}
+
+UGameViewportClient* FExtendedAnalogCursor::GetGameViewportClient() {
+	return ClampGeometryCache.GetGameViewportClient(LocalPlayerContext.IsValid() ? LocalPlayerContext.GetLocalPlayer() : nullptr);
+}
+
+const FGeometry& FExtendedAnalogCursor::GetClampGeometry() {
+	return ClampGeometryCache.GetGeometry([this]() {
+		return (GetCursorScreenSpace() == E_CursorScreenSpace::PlayerScreen
+			? UWidgetLayoutLibrary::GetPlayerScreenWidgetGeometry(LocalPlayerContext.GetPlayerController())
+			: UWidgetLayoutLibrary::GetViewportWidgetGeometry(LocalPlayerContext.GetPlayerController())
+		);
+	});
+}
+
+void FExtendedAnalogCursor::InvalidateClampGeometry() {
+	ClampGeometryCache.Invalidate();
+}
+
+void FExtendedAnalogCursor::ActOnClampGeometryInvalidated() {
+	bIsFreezeAnchorValid = false;
 }
 
 FVector2D FExtendedAnalogCursor::GetCurrentPosition() {
@@ -392,6 +485,10 @@ bool FExtendedAnalogCursor::GetFreezeCursorToCenterOfScreen() const {
 }
 
 void FExtendedAnalogCursor::SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenterOfScreen) {
+	if (bFreezeCursorToCenterOfScreen != bInFreezeCursorToCenterOfScreen) {
+		// Compute the anchor on the next tick after freezing.
+		bIsFreezeAnchorValid = false;
+	}
 	bFreezeCursorToCenterOfScreen = bInFreezeCursorToCenterOfScreen;
 	UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Freeze cursor?: %s."), (GetFreezeCursorToCenterOfScreen() ? TEXT("True") : TEXT("False")));
 }
@@ -401,6 +498,9 @@ E_CursorScreenSpace FExtendedAnalogCursor::GetCursorScreenSpace() const {
 }
 
 void FExtendedAnalogCursor::SetCursorScreenSpace(E_CursorScreenSpace InCursorScreenSpace) {
+	if (CursorScreenSpace != InCursorScreenSpace) {
+		InvalidateClampGeometry();
+	}
 	CursorScreenSpace = InCursorScreenSpace;
 }
 
@@ -440,4 +540,75 @@ void FExtendedAnalogCursor::SetProcessNavSelectEvent(bool bInProcessNavSelectEve
 		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Using deadzone: %f. Set process nav select as cursor click?: %s."), DeadZone,(bInProcessNavSelectEvent ? TEXT("True") : TEXT("False")));
 	}
 	bProcessNavSelectEvent = bInProcessNavSelectEvent;
-}
\ No newline at end of file
+}
+
+const TSharedPtr<FInteractableWidgetHitIndex>& FExtendedAnalogCursor::GetInteractableWidgetHitIndex() const {
+	return InteractableWidgetHitIndex;
+}
+
+void FExtendedAnalogCursor::SetInteractableWidgetHitIndex(TSharedPtr<FInteractableWidgetHitIndex> InInteractableWidgetHitIndex) {
+	InteractableWidgetHitIndex = InInteractableWidgetHitIndex;
+}
+
+float FExtendedAnalogCursor::GetMagnetismStrength() const {
+	return MagnetismStrength;
+}
+
+void FExtendedAnalogCursor::SetMagnetismStrength(float InMagnetismStrength) {
+	MagnetismStrength = FMath::Max(InMagnetismStrength, 0.f);
+}
+
+float FExtendedAnalogCursor::GetMagnetismRadius() const {
+	return MagnetismRadius;
+}
+
+void FExtendedAnalogCursor::SetMagnetismRadius(float InMagnetismRadius) {
+	MagnetismRadius = FMath::Max(InMagnetismRadius, 0.f);
+}
+
+bool FExtendedAnalogCursor::SnapToNearestInteractableWidget(float InMaxDistance) {
+	if (!InteractableWidgetHitIndex.IsValid()) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Can not snap the analog cursor without an InteractableWidgetHitIndex."));
+		return false;
+	}
+	if (!FSlateApplication::IsInitialized()) {
+		return false;
+	}
+	FSlateApplication& SlateApp = FSlateApplication::Get();
+	const TSharedPtr<FSlateUser> SlateUser = SlateApp.GetUser(GetOwnerUserIndex());
+	if (!SlateUser) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("ExtendedAnalogCursor << invalid SlateUser."));
+		return false;
+	}
+
+	InteractableWidgetHitIndex->ConditionalRebuild();
+	FVector2D Center = FVector2D::ZeroVector;
+	if (!InteractableWidgetHitIndex->FindNearest(SlateUser->GetCursorPosition(), InMaxDistance, Center).IsValid()) {
+		return false;
+	}
+	ClearAnalogValues();
+	UpdateCursorPosition(SlateApp, SlateUser.ToSharedRef(), Center, true);
+	return true;
+}
+
+bool FExtendedAnalogCursor::GetUseFixedStepIntegration() const {
+	return bUseFixedStepIntegration;
+}
+
+void FExtendedAnalogCursor::SetUseFixedStepIntegration(bool bInUseFixedStepIntegration) {
+	if (bUseFixedStepIntegration == bInUseFixedStepIntegration) {
+		return;
+	}
+	bUseFixedStepIntegration = bInUseFixedStepIntegration;
+	// Start from the current speed so switching modes does not cause a jump.
+	Integrator.Reset(FPlatformTime::Seconds(), CurrentSpeed);
+	Integrator.AddSample(FPlatformTime::Seconds(), GetDeadZoneAdjustedAnalogValues());
+}
+
+float FExtendedAnalogCursor::GetFixedStepRate() const {
+	return Integrator.GetStepRate();
+}
+
+void FExtendedAnalogCursor::SetFixedStepRate(float InStepRate) {
+	Integrator.SetStepRate(InStepRate);
+}
@@ -0,0 +1,250 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "InteractableWidgetHitIndex.h"
+#include "Widgets/SWidget.h"
+#include "Layout/Children.h"
+#include "Layout/Geometry.h"
+#include "HAL/PlatformTime.h"
+#include "StatsUIAdditionsPlugin.h"
+
+
+// Roots
+
+void FInteractableWidgetHitIndex::AddRoot(const TSharedRef<SWidget>& InRoot) {
+	if (Roots.ContainsByPredicate([&InRoot](const TWeakPtr<SWidget>& RootX) { return RootX.Pin() == InRoot; })) {
+		return;
+	}
+	Roots.Add(InRoot);
+	MarkDirty();
+}
+
+void FInteractableWidgetHitIndex::RemoveRoot(const TSharedRef<SWidget>& InRoot) {
+	// Also drops roots which are no longer valid.
+	const int32 NumRemoved = Roots.RemoveAll([&InRoot](const TWeakPtr<SWidget>& RootX) { return !RootX.IsValid() || RootX.Pin() == InRoot; });
+	if (NumRemoved > 0) {
+		MarkDirty();
+	}
+}
+
+void FInteractableWidgetHitIndex::ClearRoots() {
+	Roots.Empty();
+	MarkDirty();
+}
+
+// Building
+
+void FInteractableWidgetHitIndex::MarkDirty() {
+	bIsDirty = true;
+}
+
+bool FInteractableWidgetHitIndex::IsDirty() const {
+	return bIsDirty;
+}
+
+void FInteractableWidgetHitIndex::ConditionalRebuild() {
+	if (IsDirty()) {
+		Rebuild();
+		return;
+	}
+	if (GetRebuildInterval() <= 0.f) {
+		return;
+	}
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastLayoutCheckTime < GetRebuildInterval()) {
+		return;
+	}
+	LastLayoutCheckTime = Now;
+	if (HasLayoutChanged()) {
+		Rebuild();
+	}
+}
+
+void FInteractableWidgetHitIndex::Rebuild() {
+	SCOPE_CYCLE_COUNTER(STAT_AnalogCursor_HitIndexRebuild);
+
+	Entries.Reset();
+	Nodes.Reset();
+	Cells.Reset();
+
+	for (const TWeakPtr<SWidget>& RootX : Roots) {
+		const TSharedPtr<SWidget> Root = RootX.Pin();
+		if (!Root.IsValid()) {
+			continue;
+		}
+		// The root (a Sub HUD) covers its screen area, which is the initial clip rect.
+		CollectInteractableWidgets(Root.ToSharedRef(), Root->GetCachedGeometry().GetLayoutBoundingRect(), INDEX_NONE);
+	}
+
+	for (int32 i = 0; i < Entries.Num(); i++) {
+		const FSlateRect& Rect = Entries[i].Rect;
+		const FIntPoint MinCell = GetCellForPosition(Rect.GetTopLeft());
+		const FIntPoint MaxCell = GetCellForPosition(Rect.GetBottomRight());
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++) {
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++) {
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(i);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AnalogCursor_HitIndexEntries, Entries.Num());
+	LastLayoutCheckTime = FPlatformTime::Seconds();
+	bIsDirty = false;
+}
+
+void FInteractableWidgetHitIndex::CollectInteractableWidgets(const TSharedRef<SWidget>& InWidget, const FSlateRect& InClipRect, int32 InInteractableIndex) {
+	const EVisibility Visibility = InWidget->GetVisibility();
+	const FSlateRect WidgetRect = InWidget->GetCachedGeometry().GetLayoutBoundingRect();
+	FChildren* Children = InWidget->GetChildren();
+
+	// Hidden and clipped widgets are recorded as well, they affect the index once they become visible.
+	FInteractableWidgetHitNode& Node = Nodes.AddDefaulted_GetRef();
+	Node.Widget = InWidget;
+	Node.LayoutRect = WidgetRect;
+	Node.Visibility = Visibility;
+	Node.NumChildren = Children->Num();
+
+	if (!Visibility.IsVisible()) {
+		return;
+	}
+
+	bool bOverlapsClipRect = false;
+	const FSlateRect ClippedRect = WidgetRect.IntersectionWith(InClipRect, bOverlapsClipRect);
+	if (!bOverlapsClipRect) {
+		// Scrolled out of view or outside of the screen area.
+		return;
+	}
+
+	int32 InteractableIndex = InInteractableIndex;
+	if (Visibility.IsHitTestVisible()) {
+		// Non interactable widgets are indexed as well, they occlude the widgets painted below them.
+		const int32 EntryIndex = Entries.Num();
+		if (InWidget->IsInteractable() && InWidget->IsEnabled()) {
+			InteractableIndex = EntryIndex;
+		}
+		FInteractableWidgetHitEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Widget = InWidget;
+		Entry.Rect = ClippedRect;
+		Entry.LayerId = InWidget->GetPersistentState().LayerId;
+		Entry.InteractableIndex = InteractableIndex;
+	}
+
+	if (!Visibility.AreChildrenHitTestVisible()) {
+		return;
+	}
+
+	// Children are only limited by this widget's rect if it clips them (scroll boxes etc.).
+	const FSlateRect& ChildClipRect = (InWidget->GetClipping() != EWidgetClipping::Inherit ? ClippedRect : InClipRect);
+	for (int32 i = 0; i < Children->Num(); i++) {
+		CollectInteractableWidgets(Children->GetChildAt(i), ChildClipRect, InteractableIndex);
+	}
+}
+
+bool FInteractableWidgetHitIndex::HasLayoutChanged() const {
+	SCOPE_CYCLE_COUNTER(STAT_AnalogCursor_HitIndexLayoutCheck);
+
+	for (const FInteractableWidgetHitNode& NodeX : Nodes) {
+		const TSharedPtr<SWidget> Widget = NodeX.Widget.Pin();
+		if (!Widget.IsValid()
+			|| Widget->GetVisibility() != NodeX.Visibility
+			|| Widget->GetChildren()->Num() != NodeX.NumChildren
+			|| Widget->GetCachedGeometry().GetLayoutBoundingRect() != NodeX.LayoutRect
+		) {
+			return true;
+		}
+	}
+	return false;
+}
+
+FIntPoint FInteractableWidgetHitIndex::GetCellForPosition(const FVector2D& InAbsolutePosition) const {
+	return FIntPoint(FMath::FloorToInt32(InAbsolutePosition.X / CellSize), FMath::FloorToInt32(InAbsolutePosition.Y / CellSize));
+}
+
+int32 FInteractableWidgetHitIndex::FindTopmostEntry(const FVector2D& InAbsolutePosition) const {
+	const TArray<int32>* CellEntries = Cells.Find(GetCellForPosition(InAbsolutePosition));
+	if (CellEntries == nullptr) {
+		return INDEX_NONE;
+	}
+	// Cell entries are in paint order, so on equal layers the later entry is on top.
+	int32 TopmostIndex = INDEX_NONE;
+	for (int32 EntryIndex : *CellEntries) {
+		const FInteractableWidgetHitEntry& Entry = Entries[EntryIndex];
+		if (!Entry.Rect.ContainsPoint(InAbsolutePosition) || !Entry.Widget.IsValid()) {
+			continue;
+		}
+		if (TopmostIndex == INDEX_NONE || Entry.LayerId >= Entries[TopmostIndex].LayerId) {
+			TopmostIndex = EntryIndex;
+		}
+	}
+	return TopmostIndex;
+}
+
+float FInteractableWidgetHitIndex::GetRebuildInterval() const {
+	return RebuildInterval;
+}
+
+void FInteractableWidgetHitIndex::SetRebuildInterval(float InRebuildInterval) {
+	RebuildInterval = InRebuildInterval;
+}
+
+float FInteractableWidgetHitIndex::GetCellSize() const {
+	return CellSize;
+}
+
+void FInteractableWidgetHitIndex::SetCellSize(float InCellSize) {
+	CellSize = FMath::Max(InCellSize, 1.f);
+	MarkDirty();
+}
+
+// Queries
+
+int32 FInteractableWidgetHitIndex::GetNumEntries() const {
+	return Entries.Num();
+}
+
+bool FInteractableWidgetHitIndex::IsInteractableAtPosition(const FVector2D& InAbsolutePosition) const {
+	const int32 TopmostIndex = FindTopmostEntry(InAbsolutePosition);
+	return TopmostIndex != INDEX_NONE && Entries[TopmostIndex].InteractableIndex != INDEX_NONE;
+}
+
+TSharedPtr<SWidget> FInteractableWidgetHitIndex::FindNearest(const FVector2D& InAbsolutePosition, float InMaxDistance, FVector2D& OutCenter) const {
+	const FVector2D Extent(InMaxDistance, InMaxDistance);
+	const FIntPoint MinCell = GetCellForPosition(InAbsolutePosition - Extent);
+	const FIntPoint MaxCell = GetCellForPosition(InAbsolutePosition + Extent);
+
+	int32 NearestIndex = INDEX_NONE;
+	double NearestDistanceSquared = FMath::Square(InMaxDistance);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++) {
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++) {
+			const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y));
+			if (CellEntries == nullptr) {
+				continue;
+			}
+			for (int32 EntryIndex : *CellEntries) {
+				const FInteractableWidgetHitEntry& Entry = Entries[EntryIndex];
+				if (Entry.InteractableIndex != EntryIndex) {
+					// Not interactable itself.
+					continue;
+				}
+				// Distance to the rect, 0 when inside.
+				const double DX = FMath::Max3(Entry.Rect.Left - InAbsolutePosition.X, 0.0, InAbsolutePosition.X - Entry.Rect.Right);
+				const double DY = FMath::Max3(Entry.Rect.Top - InAbsolutePosition.Y, 0.0, InAbsolutePosition.Y - Entry.Rect.Bottom);
+				const double DistanceSquared = DX * DX + DY * DY;
+				if (DistanceSquared > NearestDistanceSquared || !Entry.Widget.IsValid()) {
+					continue;
+				}
+				// The cursor is moved to the center, which must hit this widget (or a widget inside it) and not whatever is painted on top.
+				const int32 TopmostIndex = FindTopmostEntry(Entry.Rect.GetCenter());
+				if (TopmostIndex != INDEX_NONE && Entries[TopmostIndex].InteractableIndex == EntryIndex) {
+					NearestDistanceSquared = DistanceSquared;
+					NearestIndex = EntryIndex;
+				}
+			}
+		}
+	}
+
+	if (NearestIndex == INDEX_NONE) {
+		return nullptr;
+	}
+	OutCenter = Entries[NearestIndex].Rect.GetCenter();
+	return Entries[NearestIndex].Widget.Pin();
+}
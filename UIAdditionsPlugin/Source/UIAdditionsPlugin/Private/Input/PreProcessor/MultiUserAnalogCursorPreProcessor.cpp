@@ -0,0 +1,165 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MultiUserAnalogCursorPreProcessor.h"
+#include "ExtendedAnalogCursor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "LogUIAdditionsPlugin.h"
+#include "Input/Events.h"
+
+
+// Cursors
+
+void FMultiUserAnalogCursorPreProcessor::AddCursor(const TSharedRef<FExtendedAnalogCursor>& InCursor) {
+	const int32 UserIndex = InCursor->GetOwnerUserIndex();
+	if (UserIndex < 0) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Can not add an analog cursor without a valid owner user index."));
+		return;
+	}
+	if (!Cursors.IsValidIndex(UserIndex)) {
+		Cursors.SetNum(UserIndex + 1);
+	}
+	if (Cursors[UserIndex].IsValid() && Cursors[UserIndex] != InCursor) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Replacing the analog cursor of user %d."), UserIndex);
+	}
+	Cursors[UserIndex] = InCursor;
+}
+
+void FMultiUserAnalogCursorPreProcessor::RemoveCursor(const TSharedRef<FExtendedAnalogCursor>& InCursor) {
+	// Search by pointer, the owner user index could have changed since the cursor was added.
+	for (TSharedPtr<FExtendedAnalogCursor>& CursorX : Cursors) {
+		if (CursorX == InCursor) {
+			CursorX.Reset();
+		}
+	}
+	UnfiledCursors.Remove(InCursor);
+	// Keep the array dense up to the highest user with a cursor.
+	while (Cursors.Num() > 0 && !Cursors.Last().IsValid()) {
+		Cursors.Pop(EAllowShrinking::No);
+	}
+}
+
+TSharedPtr<FExtendedAnalogCursor> FMultiUserAnalogCursorPreProcessor::FindCursor(int32 InUserIndex) const {
+	return Cursors.IsValidIndex(InUserIndex) ? Cursors[InUserIndex] : nullptr;
+}
+
+int32 FMultiUserAnalogCursorPreProcessor::GetNumCursors() const {
+	int32 NumCursors = 0;
+	for (const TSharedPtr<FExtendedAnalogCursor>& CursorX : Cursors) {
+		if (CursorX.IsValid()) {
+			NumCursors++;
+		}
+	}
+	return NumCursors + UnfiledCursors.Num();
+}
+
+int32 FMultiUserAnalogCursorPreProcessor::GetNumUnfiledCursors() const {
+	return UnfiledCursors.Num();
+}
+
+void FMultiUserAnalogCursorPreProcessor::RefileCursors() {
+	const TArray<TSharedPtr<FExtendedAnalogCursor>> PreviousCursors = MoveTemp(Cursors);
+	const TArray<TSharedPtr<FExtendedAnalogCursor>> PreviousUnfiledCursors = MoveTemp(UnfiledCursors);
+	Cursors.Reset();
+	UnfiledCursors.Reset();
+
+	// Cursors still in the slot of their owner keep it, a remapped cursor can not take it over.
+	for (int32 i = 0; i < PreviousCursors.Num(); i++) {
+		if (PreviousCursors[i].IsValid() && PreviousCursors[i]->GetOwnerUserIndex() == i) {
+			FileCursor(PreviousCursors[i], false);
+		}
+	}
+	for (int32 i = 0; i < PreviousCursors.Num(); i++) {
+		if (PreviousCursors[i].IsValid() && PreviousCursors[i]->GetOwnerUserIndex() != i) {
+			FileCursor(PreviousCursors[i], false);
+		}
+	}
+	for (const TSharedPtr<FExtendedAnalogCursor>& CursorX : PreviousUnfiledCursors) {
+		FileCursor(CursorX, true);
+	}
+}
+
+void FMultiUserAnalogCursorPreProcessor::FileCursor(const TSharedPtr<FExtendedAnalogCursor>& InCursor, bool bInWasUnfiled) {
+	const int32 UserIndex = InCursor->GetOwnerUserIndex();
+	const bool bSlotTaken = Cursors.IsValidIndex(UserIndex) && Cursors[UserIndex].IsValid();
+	if (UserIndex < 0 || bSlotTaken) {
+		// Only log when a cursor becomes unfiled, not on every refile while it stays unfiled.
+		if (!bInWasUnfiled) {
+			if (UserIndex < 0) {
+				UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Analog cursor has no valid owner user index, it is kept unfiled and receives no input until it has one."));
+			}
+			else {
+				UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Analog cursor of user %d collides with another cursor of that user, it is kept unfiled and receives no input until the slot is free."), UserIndex);
+			}
+		}
+		UnfiledCursors.Add(InCursor);
+		return;
+	}
+	if (!Cursors.IsValidIndex(UserIndex)) {
+		Cursors.SetNum(UserIndex + 1);
+	}
+	Cursors[UserIndex] = InCursor;
+}
+
+bool FMultiUserAnalogCursorPreProcessor::NeedsRefile() const {
+	for (int32 i = 0; i < Cursors.Num(); i++) {
+		if (Cursors[i].IsValid() && Cursors[i]->GetOwnerUserIndex() != i) {
+			return true;
+		}
+	}
+	for (const TSharedPtr<FExtendedAnalogCursor>& CursorX : UnfiledCursors) {
+		const int32 UserIndex = CursorX->GetOwnerUserIndex();
+		if (UserIndex >= 0 && !FindCursor(UserIndex).IsValid()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+FExtendedAnalogCursor* FMultiUserAnalogCursorPreProcessor::FindCursorForEvent(const FInputEvent& InInputEvent) const {
+	const int32 UserIndex = InInputEvent.GetUserIndex();
+	FExtendedAnalogCursor* Cursor = Cursors.IsValidIndex(UserIndex) ? Cursors[UserIndex].Get() : nullptr;
+	// A cursor left in a stale slot would reject the event as not relevant anyway.
+	return (Cursor && Cursor->GetOwnerUserIndex() == UserIndex) ? Cursor : nullptr;
+}
+
+// Tick
+
+void FMultiUserAnalogCursorPreProcessor::Tick(const float InDeltaTime, FSlateApplication& InSlateApp, TSharedRef<ICursor> InCursor) {
+	// Controller ids can be remapped without notice, refile before events of this frame are routed.
+	if (NeedsRefile()) {
+		RefileCursors();
+	}
+
+	for (int32 i = 0; i < Cursors.Num(); i++) {
+		// Copy, a cursor tick could lead to a cursor being removed.
+		const TSharedPtr<FExtendedAnalogCursor> CursorX = Cursors[i];
+		if (CursorX.IsValid()) {
+			CursorX->Tick(InDeltaTime, InSlateApp, InCursor);
+		}
+	}
+}
+
+// Input
+
+bool FMultiUserAnalogCursorPreProcessor::HandleKeyDownEvent(FSlateApplication& InSlateApp, const FKeyEvent& InKeyEvent) {
+	FExtendedAnalogCursor* Cursor = FindCursorForEvent(InKeyEvent);
+	return Cursor ? Cursor->HandleKeyDownEvent(InSlateApp, InKeyEvent) : false;
+}
+
+bool FMultiUserAnalogCursorPreProcessor::HandleKeyUpEvent(FSlateApplication& InSlateApp, const FKeyEvent& InKeyEvent) {
+	FExtendedAnalogCursor* Cursor = FindCursorForEvent(InKeyEvent);
+	return Cursor ? Cursor->HandleKeyUpEvent(InSlateApp, InKeyEvent) : false;
+}
+
+bool FMultiUserAnalogCursorPreProcessor::HandleAnalogInputEvent(FSlateApplication& InSlateApp, const FAnalogInputEvent& InAnalogInputEvent) {
+	FExtendedAnalogCursor* Cursor = FindCursorForEvent(InAnalogInputEvent);
+	return Cursor ? Cursor->HandleAnalogInputEvent(InSlateApp, InAnalogInputEvent) : false;
+}
+
+bool FMultiUserAnalogCursorPreProcessor::HandleMouseMoveEvent(FSlateApplication& InSlateApp, const FPointerEvent& InMouseEvent) {
+	FExtendedAnalogCursor* Cursor = FindCursorForEvent(InMouseEvent);
+	return Cursor ? Cursor->HandleMouseMoveEvent(InSlateApp, InMouseEvent) : false;
+}
+
+const TCHAR* FMultiUserAnalogCursorPreProcessor::GetDebugName() const {
+	return TEXT("MultiUserAnalogCursorPreProcessor");
+}
@@ -7,6 +7,11 @@
 #include "PlayerControllerInputModes.h"
 #include "Framework/Application/SlateApplication.h"
 #include "GameFramework/PlayerInput.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "Engine/World.h"
+#include "Engine/StreamableManager.h"
+#include "HUDCore.h"
 
 
 // Setup
@@ -17,5 +22,37 @@ APlayerControllerCore::APlayerControllerCore() {
 
 void APlayerControllerCore::ReceivedPlayer() {
 	Super::ReceivedPlayer();
+
+	if (bPreloadHUDWidgetClasses) {
+		// The HUD class is not replicated yet, the game mode (or its defaults on clients) knows which HUD will be spawned.
+		const UWorld* World = GetWorld();
+		const AGameModeBase* GameMode = IsValid(World) ? World->GetAuthGameMode() : nullptr;
+		if (!IsValid(GameMode) && IsValid(World) && IsValid(World->GetGameState())) {
+			GameMode = World->GetGameState()->GetDefaultGameMode();
+		}
+		UClass* HUDClass = IsValid(GameMode) ? GameMode->HUDClass.Get() : nullptr;
+		if (IsValid(HUDClass) && HUDClass->IsChildOf(AHUDCore::StaticClass())) {
+			PreloadHUDWidgetClasses(HUDClass);
+		}
+	}
+
 	OnReceivedPlayer.Broadcast();
 }
+
+// HUD
+
+void APlayerControllerCore::PreloadHUDWidgetClasses(TSubclassOf<AHUDCore> InHUDClass) {
+	if (!IsValid(InHUDClass)) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Invalid InHUDClass."));
+		return;
+	}
+	ReleasePreloadedHUDWidgetClasses();
+	HUDWidgetClassesHandle = AHUDCore::PreloadHUDWidgetClasses(InHUDClass);
+}
+
+void APlayerControllerCore::ReleasePreloadedHUDWidgetClasses() {
+	if (HUDWidgetClassesHandle.IsValid()) {
+		HUDWidgetClassesHandle->ReleaseHandle();
+		HUDWidgetClassesHandle.Reset();
+	}
+}
@@ -0,0 +1,15 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "UIAdditionsPluginSettings.h"
+
+
+// Setup
+
+FName UUIAdditionsPluginSettings::GetCategoryName() const {
+	return FName(TEXT("Plugins"));
+}
+
+// Lazy
+
+int64 UUIAdditionsPluginSettings::GetLazyContentMemoryBudgetBytes() const {
+	return (int64)LazyContentMemoryBudgetMB * 1024 * 1024;
+}
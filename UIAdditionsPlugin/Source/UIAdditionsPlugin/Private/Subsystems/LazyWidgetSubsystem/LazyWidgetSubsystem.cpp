@@ -0,0 +1,263 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "LazyWidgetSubsystem.h"
+#include "LazyWidget.h"
+#include "MenuWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Image.h"
+#include "Engine/Texture.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "SlateUtils.h"
+#include "UIAdditionsPluginSettings.h"
+#include "LogUIAdditionsPlugin.h"
+
+
+// Setup
+
+void ULazyWidgetSubsystem::Initialize(FSubsystemCollectionBase& InCollection) {
+	Super::Initialize(InCollection);
+
+	MemoryBudgetBytes = GetDefault<UUIAdditionsPluginSettings>()->GetLazyContentMemoryBudgetBytes();
+}
+
+// Lazy
+
+void ULazyWidgetSubsystem::CollectContentMemory(UUserWidget* InContent, int64& OutWidgetBytes, TMap<UObject*, int64>& OutResourceBytes) {
+	if (!IsValid(InContent)) {
+		return;
+	}
+
+	OutWidgetBytes += InContent->GetClass()->GetStructureSize();
+
+	if (!IsValid(InContent->WidgetTree)) {
+		return;
+	}
+	InContent->WidgetTree->ForEachWidgetAndDescendants([&OutWidgetBytes, &OutResourceBytes](UWidget* InWidget) {
+		if (!IsValid(InWidget)) {
+			return;
+		}
+
+		// The tree of a nested user widget is not part of this tree.
+		UUserWidget* NestedUserWidget = Cast<UUserWidget>(InWidget);
+		if (IsValid(NestedUserWidget)) {
+			CollectContentMemory(NestedUserWidget, OutWidgetBytes, OutResourceBytes);
+			return;
+		}
+
+		OutWidgetBytes += InWidget->GetClass()->GetStructureSize();
+
+		const UImage* Image = Cast<UImage>(InWidget);
+		if (!IsValid(Image)) {
+			return;
+		}
+		UTexture* Texture = Cast<UTexture>(Image->GetBrush().GetResourceObject());
+		if (IsValid(Texture) && !OutResourceBytes.Contains(Texture)) {
+			// Exclusive only counts the texture resource, not its UObject subobjects.
+			FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+			Texture->GetResourceSizeEx(ResourceSize);
+			OutResourceBytes.Add(Texture, ResourceSize.GetTotalMemoryBytes());
+		}
+	});
+}
+
+int64 ULazyWidgetSubsystem::EstimateContentMemory(UUserWidget* InContent) {
+	int64 Bytes = 0;
+	TMap<UObject*, int64> ResourceBytes;
+	CollectContentMemory(InContent, Bytes, ResourceBytes);
+	for (const TPair<UObject*, int64>& ResourceX : ResourceBytes) {
+		Bytes += ResourceX.Value;
+	}
+	return Bytes;
+}
+
+void ULazyWidgetSubsystem::RegisterLoadedContent(ULazyWidget* InLazyWidget) {
+	if (!IsValid(InLazyWidget)) {
+		return;
+	}
+
+	UnRegisterLoadedContent(InLazyWidget);
+
+	FLazyContentMemoryEntry Entry;
+	Entry.LazyWidget = InLazyWidget;
+	Entry.Menu = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(InLazyWidget);
+	Entry.LastVisibleTime = FPlatformTime::Seconds();
+
+	TMap<UObject*, int64> ResourceBytes;
+	CollectContentMemory(Cast<UUserWidget>(InLazyWidget->GetContent()), Entry.WidgetBytes, ResourceBytes);
+	Entry.EstimatedBytes = Entry.WidgetBytes;
+	TotalEstimatedBytes += Entry.WidgetBytes;
+
+	for (const TPair<UObject*, int64>& ResourceX : ResourceBytes) {
+		Entry.EstimatedBytes += ResourceX.Value;
+		Entry.Resources.Add(ResourceX.Key);
+
+		// Shared resources are only added to the total by the first content referencing them.
+		FLazyContentSharedResource& SharedResource = SharedResources.FindOrAdd(ResourceX.Key);
+		if (SharedResource.RefCount == 0) {
+			SharedResource.Bytes = ResourceX.Value;
+			TotalEstimatedBytes += SharedResource.Bytes;
+		}
+		SharedResource.RefCount++;
+	}
+
+	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: registered %lld bytes of lazy content, %lld bytes total."), *InLazyWidget->GetName(), Entry.EstimatedBytes, TotalEstimatedBytes);
+
+	Entries.Add(InLazyWidget, MoveTemp(Entry));
+
+	EnforceMemoryBudget(InLazyWidget);
+}
+
+void ULazyWidgetSubsystem::UnRegisterLoadedContent(ULazyWidget* InLazyWidget) {
+	FLazyContentMemoryEntry Entry;
+	if (!Entries.RemoveAndCopyValue(InLazyWidget, Entry)) {
+		return;
+	}
+
+	TotalEstimatedBytes -= Entry.WidgetBytes;
+
+	for (const TObjectKey<UObject>& ResourceX : Entry.Resources) {
+		FLazyContentSharedResource* SharedResource = SharedResources.Find(ResourceX);
+		if (SharedResource == nullptr) {
+			continue;
+		}
+		SharedResource->RefCount--;
+		if (SharedResource->RefCount <= 0) {
+			// The last content referencing the resource is gone.
+			TotalEstimatedBytes -= SharedResource->Bytes;
+			SharedResources.Remove(ResourceX);
+		}
+	}
+}
+
+void ULazyWidgetSubsystem::MarkContentVisible(ULazyWidget* InLazyWidget) {
+	FLazyContentMemoryEntry* Entry = Entries.Find(InLazyWidget);
+	if (Entry != nullptr) {
+		Entry->LastVisibleTime = FPlatformTime::Seconds();
+		Entry->bIsVisible = true;
+	}
+}
+
+void ULazyWidgetSubsystem::MarkContentHidden(ULazyWidget* InLazyWidget) {
+	FLazyContentMemoryEntry* Entry = Entries.Find(InLazyWidget);
+	if (Entry != nullptr && Entry->bIsVisible) {
+		// Only the transition counts, hiding hidden content again does not make it more recent.
+		Entry->LastVisibleTime = FPlatformTime::Seconds();
+		Entry->bIsVisible = false;
+	}
+}
+
+bool ULazyWidgetSubsystem::IsEnforcingMemoryBudget() const {
+	return bIsEnforcingMemoryBudget;
+}
+
+void ULazyWidgetSubsystem::EnforceMemoryBudget(const ULazyWidget* InLoadingLazyWidget) {
+	if (GetMemoryBudget() <= 0 || GetTotalEstimatedMemory() <= GetMemoryBudget() || bIsEnforcingMemoryBudget) {
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	TArray<FLazyContentMemoryEntry> Candidates;
+
+	for (TPair<TObjectKey<ULazyWidget>, FLazyContentMemoryEntry>& EntryX : Entries) {
+		ULazyWidget* LazyWidgetX = EntryX.Value.LazyWidget.Get();
+		if (!IsValid(LazyWidgetX) || LazyWidgetX == InLoadingLazyWidget) {
+			continue;
+		}
+		if (!LazyWidgetX->IsHiddenByLoadCondition()) {
+			// Either visible, or hidden in a way none of its load conditions observe. Nothing would load evicted content again once it becomes visible.
+			if (USlateUtils::IsVisibleInHierarchy(LazyWidgetX, LazyWidgetX->GetLoadControlledByScrollVisibility())) {
+				// Visible content is never evicted, it is as recent as it gets.
+				EntryX.Value.LastVisibleTime = Now;
+				EntryX.Value.bIsVisible = true;
+			}
+			continue;
+		}
+		if (EntryX.Value.bIsVisible) {
+			// Hidden without being told, keep the last time it was known to be visible.
+			EntryX.Value.bIsVisible = false;
+		}
+		Candidates.Add(EntryX.Value);
+	}
+
+	Candidates.Sort([](const FLazyContentMemoryEntry& InA, const FLazyContentMemoryEntry& InB) {
+		const int32 PriorityA = InA.LazyWidget->GetEvictionPriority();
+		const int32 PriorityB = InB.LazyWidget->GetEvictionPriority();
+		if (PriorityA != PriorityB) {
+			return PriorityA < PriorityB;
+		}
+		return InA.LastVisibleTime < InB.LastVisibleTime;
+	});
+
+	bIsEnforcingMemoryBudget = true;
+	bool bCollectGarbage = false;
+
+	for (const FLazyContentMemoryEntry& CandidateX : Candidates) {
+		if (GetTotalEstimatedMemory() <= GetMemoryBudget()) {
+			break;
+		}
+		ULazyWidget* LazyWidgetX = CandidateX.LazyWidget.Get();
+		if (IsValid(LazyWidgetX)) {
+			UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("%s: evicting %lld bytes of lazy content, memory budget of %lld bytes exceeded."), *LazyWidgetX->GetName(), CandidateX.EstimatedBytes, GetMemoryBudget());
+			bCollectGarbage |= LazyWidgetX->GetCollectGarbageOnUnload();
+			// Unregisters through UnloadContent.
+			LazyWidgetX->UnloadContent();
+		}
+	}
+
+	bIsEnforcingMemoryBudget = false;
+
+	if (bCollectGarbage) {
+		// Once for all evicted content, see ULazyWidget::UnloadContent.
+		UKismetSystemLibrary::CollectGarbage();
+	}
+
+	if (GetTotalEstimatedMemory() > GetMemoryBudget()) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Lazy content memory budget of %lld bytes exceeded by visible content (%lld bytes)."), GetMemoryBudget(), GetTotalEstimatedMemory());
+	}
+}
+
+int64 ULazyWidgetSubsystem::GetTotalEstimatedMemory() const {
+	return TotalEstimatedBytes;
+}
+
+int64 ULazyWidgetSubsystem::GetEstimatedMemoryForLazyWidget(const ULazyWidget* InLazyWidget) const {
+	const FLazyContentMemoryEntry* Entry = Entries.Find(InLazyWidget);
+	return Entry != nullptr ? Entry->EstimatedBytes : 0;
+}
+
+int64 ULazyWidgetSubsystem::GetEstimatedMemoryForMenu(const UMenuWidget* InMenu, bool bInIncludeSubMenus) const {
+	if (!IsValid(InMenu)) {
+		return 0;
+	}
+
+	int64 Bytes = 0;
+	TSet<TObjectKey<UObject>> CountedResources;
+	for (const TPair<TObjectKey<ULazyWidget>, FLazyContentMemoryEntry>& EntryX : Entries) {
+		const UMenuWidget* MenuX = EntryX.Value.Menu.Get();
+		if (!IsValid(MenuX)) {
+			continue;
+		}
+		if (MenuX != InMenu && !(bInIncludeSubMenus && USlateUtils::FindAncestorWidget(MenuX, InMenu))) {
+			continue;
+		}
+		Bytes += EntryX.Value.WidgetBytes;
+		for (const TObjectKey<UObject>& ResourceX : EntryX.Value.Resources) {
+			bool bIsAlreadyCounted = false;
+			CountedResources.Add(ResourceX, &bIsAlreadyCounted);
+			const FLazyContentSharedResource* SharedResource = SharedResources.Find(ResourceX);
+			if (!bIsAlreadyCounted && SharedResource != nullptr) {
+				Bytes += SharedResource->Bytes;
+			}
+		}
+	}
+	return Bytes;
+}
+
+int64 ULazyWidgetSubsystem::GetMemoryBudget() const {
+	return MemoryBudgetBytes;
+}
+
+void ULazyWidgetSubsystem::SetMemoryBudget(int64 InMemoryBudgetBytes) {
+	MemoryBudgetBytes = FMath::Max<int64>(InMemoryBudgetBytes, 0);
+	EnforceMemoryBudget(nullptr);
+}
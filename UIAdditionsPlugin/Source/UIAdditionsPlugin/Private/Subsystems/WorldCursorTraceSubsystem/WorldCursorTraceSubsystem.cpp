@@ -0,0 +1,211 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "WorldCursorTraceSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateUser.h"
+#include "Blueprint/SlateBlueprintLibrary.h"
+#include "WorldCursorModifierComponent.h"
+#include "SlateUtils.h"
+#include "StatsUIAdditionsPlugin.h"
+#include "LogUIAdditionsPlugin.h"
+
+
+// Setup
+
+bool UWorldCursorTraceSubsystem::DoesSupportWorldType(const EWorldType::Type InWorldType) const {
+	return InWorldType == EWorldType::Game || InWorldType == EWorldType::PIE;
+}
+
+// Tick
+
+TStatId UWorldCursorTraceSubsystem::GetStatId() const {
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldCursorTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UWorldCursorTraceSubsystem::Tick(float InDeltaTime) {
+	Super::Tick(InDeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_WorldCursorTrace_Tick);
+
+	// Drop players which no longer exist.
+	Entries.RemoveAll([](const FWorldCursorTraceEntry& EntryX) { return !EntryX.PlayerController.IsValid(); });
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	TArray<TPair<TWeakObjectPtr<APlayerController>, FS_WorldCursorTraceResult>, TInlineAllocator<4>> UpdatedResults;
+	for (FWorldCursorTraceEntry& EntryX : Entries) {
+		if (TickEntry(EntryX, Time)) {
+			UpdatedResults.Add(TPair<TWeakObjectPtr<APlayerController>, FS_WorldCursorTraceResult>(EntryX.PlayerController, EntryX.Result));
+		}
+	}
+
+	// Broadcast after the loop, listeners can register or unregister players.
+	for (const TPair<TWeakObjectPtr<APlayerController>, FS_WorldCursorTraceResult>& UpdatedResultX : UpdatedResults) {
+		APlayerController* PC = UpdatedResultX.Key.Get();
+		if (IsValid(PC)) {
+			OnWorldCursorTraceUpdated.Broadcast(PC, UpdatedResultX.Value);
+		}
+	}
+}
+
+bool UWorldCursorTraceSubsystem::TickEntry(FWorldCursorTraceEntry& InEntry, double InTime) {
+	APlayerController* PC = InEntry.PlayerController.Get();
+
+	const bool bCollected = CollectAsyncTrace(InEntry);
+	if (InEntry.PendingAsyncTrace.IsValid()) {
+		// Wait for the pending trace before starting a new one.
+		return bCollected;
+	}
+
+	FVector2D ScreenPosition = FVector2D::ZeroVector;
+	if (!GetWorldCursorScreenPosition(PC, ScreenPosition)) {
+		return bCollected;
+	}
+	FVector CameraLocation = FVector::ZeroVector;
+	FRotator CameraRotation = FRotator::ZeroRotator;
+	PC->GetPlayerViewPoint(CameraLocation, CameraRotation);
+
+	// Reuse the result while nothing relevant changed.
+	const bool bIsUnchanged = (
+		!InEntry.bForceTrace
+		&& InEntry.Result.bIsValid
+		&& ScreenPosition.Equals(InEntry.TracedScreenPosition, 0.5f)
+		&& CameraLocation.Equals(InEntry.TracedCameraLocation, 0.1f)
+		&& CameraRotation.Equals(InEntry.TracedCameraRotation, 0.01f)
+		&& (InEntry.Settings.MaxCachedResultAge < 0.f || InTime - InEntry.TracedTime <= InEntry.Settings.MaxCachedResultAge)
+	);
+	if (bIsUnchanged) {
+		INC_DWORD_STAT(STAT_WorldCursorTrace_Cached);
+		return bCollected;
+	}
+
+	FVector WorldOrigin = FVector::ZeroVector;
+	FVector WorldDirection = FVector::ZeroVector;
+	if (!PC->DeprojectScreenPositionToWorld(ScreenPosition.X, ScreenPosition.Y, WorldOrigin, WorldDirection)) {
+		return bCollected;
+	}
+	const FVector TraceEnd = WorldOrigin + WorldDirection * InEntry.Settings.TraceDistance;
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(WorldCursorTrace), InEntry.Settings.bTraceComplex);
+	Params.AddIgnoredActor(PC->GetPawn());
+
+	InEntry.TracedScreenPosition = ScreenPosition;
+	InEntry.TracedCameraLocation = CameraLocation;
+	InEntry.TracedCameraRotation = CameraRotation;
+	InEntry.TracedTime = InTime;
+	InEntry.bForceTrace = false;
+	INC_DWORD_STAT(STAT_WorldCursorTrace_Traces);
+
+	if (InEntry.Settings.bAsync) {
+		InEntry.PendingAsyncTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, WorldOrigin, TraceEnd, InEntry.Settings.TraceChannel, Params);
+		return bCollected;
+	}
+
+	FHitResult Hit;
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, WorldOrigin, TraceEnd, InEntry.Settings.TraceChannel, Params);
+	SetResult(InEntry, bHit ? &Hit : nullptr);
+	return true;
+}
+
+bool UWorldCursorTraceSubsystem::CollectAsyncTrace(FWorldCursorTraceEntry& InEntry) {
+	if (!InEntry.PendingAsyncTrace.IsValid()) {
+		return false;
+	}
+	FTraceDatum TraceDatum;
+	if (!GetWorld()->QueryTraceData(InEntry.PendingAsyncTrace, TraceDatum)) {
+		if (!GetWorld()->IsTraceHandleValid(InEntry.PendingAsyncTrace, false)) {
+			// The trace data expired, trace again.
+			InEntry.PendingAsyncTrace = FTraceHandle();
+			InEntry.bForceTrace = true;
+		}
+		return false;
+	}
+	InEntry.PendingAsyncTrace = FTraceHandle();
+
+	const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& HitX) { return HitX.bBlockingHit; });
+	SetResult(InEntry, Hit);
+	return true;
+}
+
+void UWorldCursorTraceSubsystem::SetResult(FWorldCursorTraceEntry& InEntry, const FHitResult* InHit) {
+	InEntry.Result.bIsValid = true;
+	InEntry.Result.bBlockingHit = InHit != nullptr;
+	InEntry.Result.Hit = InHit ? *InHit : FHitResult();
+	InEntry.Result.ScreenPosition = InEntry.TracedScreenPosition;
+}
+
+bool UWorldCursorTraceSubsystem::GetWorldCursorScreenPosition(APlayerController* InPlayerController, FVector2D& OutScreenPosition) const {
+	const ULocalPlayer* LocalPlayer = InPlayerController->GetLocalPlayer();
+	const UGameViewportClient* GameViewportClient = IsValid(LocalPlayer) ? LocalPlayer->ViewportClient.Get() : nullptr;
+	if (!IsValid(GameViewportClient)) {
+		return false;
+	}
+
+	const APawn* Pawn = InPlayerController->GetPawn();
+	const UWorldCursorModifierComponent* WorldCursorModifier = IsValid(Pawn) ? Pawn->FindComponentByClass<UWorldCursorModifierComponent>() : nullptr;
+	if (IsValid(WorldCursorModifier) && WorldCursorModifier->GetDesiresCenteredWorldCursor()) {
+		// Center of the player's area of the viewport, in viewport pixels.
+		FVector2D ViewportSize = FVector2D::ZeroVector;
+		GameViewportClient->GetViewportSize(ViewportSize);
+		OutScreenPosition = (FVector2D(LocalPlayer->Origin) + FVector2D(LocalPlayer->Size) * 0.5f) * ViewportSize;
+		return true;
+	}
+
+	const TSharedPtr<FSlateUser> SlateUser = USlateUtils::GetSlateUserForPlayerController(InPlayerController);
+	if (!SlateUser.IsValid()) {
+		return false;
+	}
+	FVector2D ViewportPosition = FVector2D::ZeroVector;
+	USlateBlueprintLibrary::AbsoluteToViewport(GetWorld(), SlateUser->GetCursorPosition(), OutScreenPosition, ViewportPosition);
+	return true;
+}
+
+// Trace
+
+FWorldCursorTraceEntry* UWorldCursorTraceSubsystem::FindEntry(const APlayerController* InPlayerController) {
+	return Entries.FindByPredicate([InPlayerController](const FWorldCursorTraceEntry& EntryX) { return EntryX.PlayerController.Get() == InPlayerController; });
+}
+
+const FWorldCursorTraceEntry* UWorldCursorTraceSubsystem::FindEntry(const APlayerController* InPlayerController) const {
+	return Entries.FindByPredicate([InPlayerController](const FWorldCursorTraceEntry& EntryX) { return EntryX.PlayerController.Get() == InPlayerController; });
+}
+
+void UWorldCursorTraceSubsystem::RegisterPlayer(APlayerController* InPlayerController, const FS_WorldCursorTraceSettings& InSettings) {
+	if (!IsValid(InPlayerController) || !InPlayerController->IsLocalPlayerController()) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Can only trace the world cursor of a valid local player controller."));
+		return;
+	}
+	FWorldCursorTraceEntry* Entry = FindEntry(InPlayerController);
+	if (Entry == nullptr) {
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->PlayerController = InPlayerController;
+	}
+	Entry->Settings = InSettings;
+	Entry->bForceTrace = true;
+}
+
+void UWorldCursorTraceSubsystem::UnRegisterPlayer(APlayerController* InPlayerController) {
+	// A pending async trace is simply never queried.
+	Entries.RemoveAll([InPlayerController](const FWorldCursorTraceEntry& EntryX) { return EntryX.PlayerController.Get() == InPlayerController; });
+}
+
+bool UWorldCursorTraceSubsystem::IsPlayerRegistered(const APlayerController* InPlayerController) const {
+	return FindEntry(InPlayerController) != nullptr;
+}
+
+bool UWorldCursorTraceSubsystem::GetTraceResult(const APlayerController* InPlayerController, FS_WorldCursorTraceResult& OutResult) const {
+	const FWorldCursorTraceEntry* Entry = FindEntry(InPlayerController);
+	if (Entry == nullptr || !Entry->Result.bIsValid) {
+		return false;
+	}
+	OutResult = Entry->Result;
+	return true;
+}
+
+void UWorldCursorTraceSubsystem::InvalidateTraceResult(const APlayerController* InPlayerController) {
+	FWorldCursorTraceEntry* Entry = FindEntry(InPlayerController);
+	if (Entry != nullptr) {
+		Entry->bForceTrace = true;
+	}
+}
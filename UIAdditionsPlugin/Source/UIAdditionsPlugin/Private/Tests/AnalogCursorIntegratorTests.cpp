@@ -0,0 +1,96 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "AnalogCursorIntegrator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+/* Advances InIntegrator from 0 to InDuration in frames of InFrameTime, returns the total displacement. */
+static FVector2D AdvanceInFrames(FAnalogCursorIntegrator& InIntegrator, double InDuration, double InFrameTime) {
+	FVector2D Displacement = FVector2D::ZeroVector;
+	const int32 NumFrames = FMath::CeilToInt32(InDuration / InFrameTime);
+	for (int32 i = 1; i <= NumFrames; i++) {
+		Displacement += InIntegrator.Advance(FMath::Min(i * InFrameTime, InDuration));
+	}
+	return Displacement;
+}
+
+/* An integrator at time 0 with the same stick input: full tilt, then half tilt diagonally. */
+static void SetupIntegrator(FAnalogCursorIntegrator& InIntegrator) {
+	InIntegrator.SetParameters(AnalogCursorMode::Accelerated, 1000.f, 1500.f);
+	InIntegrator.SetStepRate(240.f);
+	InIntegrator.Reset(0.0);
+	InIntegrator.AddSample(0.0, FVector2D(1.0, 0.0));
+	InIntegrator.AddSample(0.25, FVector2D(0.5, -0.5));
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnalogCursorIntegratorFixedStepTest, "UIAdditionsPlugin.Input.AnalogCursorIntegrator.FixedStep", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FAnalogCursorIntegratorFixedStepTest::RunTest(const FString& InParameters) {
+	FAnalogCursorIntegrator Integrator30;
+	FAnalogCursorIntegrator Integrator144;
+	FAnalogCursorIntegrator IntegratorUneven;
+	SetupIntegrator(Integrator30);
+	SetupIntegrator(Integrator144);
+	SetupIntegrator(IntegratorUneven);
+
+	const FVector2D Displacement30 = AdvanceInFrames(Integrator30, 1.0, 1.0 / 30.0);
+	const FVector2D Displacement144 = AdvanceInFrames(Integrator144, 1.0, 1.0 / 144.0);
+	// Frame times which do not line up with the steps, the remainder is carried.
+	const FVector2D DisplacementUneven = AdvanceInFrames(IntegratorUneven, 1.0, 0.0173);
+
+	TestTrue(TEXT("The cursor moved."), Displacement30.X > 0.0 && Displacement30.Y < 0.0);
+	TestTrue(TEXT("The displacement does not depend on the frame rate (30 vs 144)."), Displacement30.Equals(Displacement144, 0.01));
+	TestTrue(TEXT("The displacement does not depend on the frame rate (30 vs uneven)."), Displacement30.Equals(DisplacementUneven, 0.01));
+	TestTrue(TEXT("The speed does not depend on the frame rate."), Integrator30.GetSpeed().Equals(Integrator144.GetSpeed(), 0.01));
+	TestFalse(TEXT("All samples were applied."), Integrator30.HasPendingSamples());
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnalogCursorIntegratorCatchUpTest, "UIAdditionsPlugin.Input.AnalogCursorIntegrator.MaxCatchUpTime", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FAnalogCursorIntegratorCatchUpTest::RunTest(const FString& InParameters) {
+	const float MaxSpeed = 1500.f;
+
+	// A single hitch of a second.
+	FAnalogCursorIntegrator HitchIntegrator;
+	HitchIntegrator.SetParameters(AnalogCursorMode::Direct, 1000.f, MaxSpeed);
+	HitchIntegrator.Reset(0.0);
+	HitchIntegrator.AddSample(0.0, FVector2D(1.0, 0.0));
+	const FVector2D HitchDisplacement = HitchIntegrator.Advance(1.0);
+
+	// Only the last 0.1 seconds (MaxCatchUpTime) of the hitch are simulated.
+	FAnalogCursorIntegrator CatchUpIntegrator;
+	CatchUpIntegrator.SetParameters(AnalogCursorMode::Direct, 1000.f, MaxSpeed);
+	CatchUpIntegrator.Reset(0.9);
+	CatchUpIntegrator.AddSample(0.9, FVector2D(1.0, 0.0));
+	const FVector2D CatchUpDisplacement = CatchUpIntegrator.Advance(1.0);
+
+	TestTrue(TEXT("A hitch is clamped to the catch up time."), HitchDisplacement.Equals(CatchUpDisplacement, 0.01));
+	TestTrue(TEXT("A hitch does not turn into a burst of motion."), HitchDisplacement.X <= MaxSpeed * 0.1 + 0.01);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnalogCursorIntegratorResetTest, "UIAdditionsPlugin.Input.AnalogCursorIntegrator.Reset", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FAnalogCursorIntegratorResetTest::RunTest(const FString& InParameters) {
+	FAnalogCursorIntegrator Integrator;
+	Integrator.SetParameters(AnalogCursorMode::Accelerated, 1000.f, 1500.f);
+	Integrator.Reset(0.0, FVector2D(400.0, 0.0));
+	TestTrue(TEXT("Reset keeps the speed it is seeded with."), Integrator.GetSpeed().Equals(FVector2D(400.0, 0.0)));
+
+	// Full tilt keeps accelerating from the seeded speed instead of from 0.
+	Integrator.AddSample(0.0, FVector2D(1.0, 0.0));
+	Integrator.Advance(0.05);
+	TestTrue(TEXT("Motion continues from the seeded speed."), Integrator.GetSpeed().X > 400.0);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
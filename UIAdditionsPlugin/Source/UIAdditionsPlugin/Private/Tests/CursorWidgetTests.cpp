@@ -0,0 +1,49 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "UIAdditionsPluginTestTypes.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCursorWidgetContextBatchTest, "UIAdditionsPlugin.UI.CursorWidget.ContextBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FCursorWidgetContextBatchTest::RunTest(const FString& InParameters) {
+	AddExpectedError(TEXT("were not committed by the end of the frame"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	UTestCursorWidget* CursorWidget = NewObject<UTestCursorWidget>(GetTransientPackage());
+	int32 NumNotifications = 0;
+	CursorWidget->OnCursorContextMaskChanged.AddLambda([&NumNotifications](const TBitArray<>& InOldMask, const TBitArray<>& InNewMask) {
+		NumNotifications++;
+	});
+
+	{
+		FScopedCursorContextBatch OuterBatch(CursorWidget);
+		{
+			FScopedCursorContextBatch InnerBatch(CursorWidget);
+			CursorWidget->AddCursorContext(TEXT("Test.CursorWidget.A"));
+			CursorWidget->AddCursorContext(TEXT("Test.CursorWidget.B"));
+		}
+		TestEqual(TEXT("A nested batch does not notify on commit."), NumNotifications, 0);
+		TestTrue(TEXT("An open batch is bound to the end of the frame."), FCoreDelegates::OnEndFrame.IsBoundToObject(CursorWidget));
+	}
+	TestEqual(TEXT("The outermost scoped batch notifies once."), NumNotifications, 1);
+	TestFalse(TEXT("A committed batch unbinds from the end of the frame."), FCoreDelegates::OnEndFrame.IsBoundToObject(CursorWidget));
+
+	// An unbalanced batch is committed at the end of the frame.
+	CursorWidget->BeginCursorContextBatch();
+	CursorWidget->RemoveCursorContext(TEXT("Test.CursorWidget.A"));
+	TestEqual(TEXT("An open batch holds back the notification."), NumNotifications, 1);
+	CursorWidget->ActOnEndFrame();
+	TestEqual(TEXT("The unbalanced batch is committed at the end of the frame."), NumNotifications, 2);
+	TestFalse(TEXT("The end of frame hook unbinds once the batch is committed."), FCoreDelegates::OnEndFrame.IsBoundToObject(CursorWidget));
+
+	CursorWidget->RemoveCursorContext(TEXT("Test.CursorWidget.B"));
+	TestEqual(TEXT("Changes after the forced commit notify immediately."), NumNotifications, 3);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,105 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "SDeferPaintWidget.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Input/HittestGrid.h"
+#include "Layout/Geometry.h"
+#include "Misc/App.h"
+#include "Rendering/DrawElements.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/SWindow.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+/* Leaf widget counting how often it is painted. */
+class SPaintCountingWidget : public SLeafWidget {
+
+public:
+
+	SLATE_BEGIN_ARGS(SPaintCountingWidget) {}
+	SLATE_END_ARGS()
+
+	mutable int32 NumPaints = 0;
+
+	void Construct(const FArguments& InArgs) {}
+
+	virtual FVector2D ComputeDesiredSize(float InLayoutScaleMultiplier) const override {
+		return FVector2D(32.f, 32.f);
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override {
+		NumPaints++;
+		return LayerId;
+	}
+
+};
+
+/* Paints InWidget and the deferred paints it queued into InElementList, like a window paints a frame. */
+static void PaintFrame(const TSharedRef<SWidget>& InWidget, FSlateWindowElementList& InElementList) {
+	const FVector2D Size(256.f, 256.f);
+	const FGeometry Geometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+	const FSlateRect CullingRect(0.f, 0.f, Size.X, Size.Y);
+	FHittestGrid HittestGrid;
+	FPaintArgs PaintArgs(nullptr, HittestGrid, FVector2D::ZeroVector, FApp::GetCurrentTime(), FApp::GetDeltaTime());
+
+	InElementList.ResetElementList();
+	InWidget->SlatePrepass(1.f);
+	const int32 MaxLayerId = InWidget->Paint(PaintArgs, Geometry, CullingRect, InElementList, 0, FWidgetStyle(), true);
+	InElementList.PaintDeferred(MaxLayerId, CullingRect);
+}
+
+/* Paints InNumFrames frames of a deferred widget around a static child, returns how often the child was painted. */
+static int32 CountChildPaints(bool bInRetainDeferredContent, int32 InNumFrames) {
+	TSharedRef<SPaintCountingWidget> Child = SNew(SPaintCountingWidget);
+	TSharedRef<SDeferPaintWidget> DeferPaintWidget = SNew(SDeferPaintWidget)
+		.RetainDeferredContent(bInRetainDeferredContent)
+		[Child];
+
+	TSharedRef<SWindow> Window = SNew(SWindow);
+	FSlateWindowElementList ElementList(Window);
+	for (int32 i = 0; i < InNumFrames; i++) {
+		PaintFrame(DeferPaintWidget, ElementList);
+	}
+	return Child->NumPaints;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDeferPaintWidgetRetainedTest, "UIAdditionsPlugin.Slate.DeferPaintWidget.Retained", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FDeferPaintWidgetRetainedTest::RunTest(const FString& InParameters) {
+	if (!FSlateApplication::IsInitialized()) {
+		AddWarning(TEXT("Slate is not initialized, skipped."));
+		return true;
+	}
+
+	const int32 NumFrames = 10;
+
+	const int32 NumImmediatePaints = CountChildPaints(false, NumFrames);
+	TestEqual(TEXT("Without retaining, the deferred child is painted once every frame, only by the deferred pass."), NumImmediatePaints, NumFrames);
+
+	const int32 NumRetainedPaints = CountChildPaints(true, NumFrames);
+	TestTrue(TEXT("The retained child was painted."), NumRetainedPaints > 0);
+	TestTrue(TEXT("The retained child is not repainted while nothing changed."), NumRetainedPaints < NumFrames);
+	AddInfo(FString::Printf(TEXT("Child paints over %d frames: %d immediate, %d retained."), NumFrames, NumImmediatePaints, NumRetainedPaints));
+
+	// Invalidating the retained content repaints it once.
+	TSharedRef<SPaintCountingWidget> Child = SNew(SPaintCountingWidget);
+	TSharedRef<SDeferPaintWidget> DeferPaintWidget = SNew(SDeferPaintWidget)
+		.RetainDeferredContent(true)
+		[Child];
+	TSharedRef<SWindow> Window = SNew(SWindow);
+	FSlateWindowElementList ElementList(Window);
+	PaintFrame(DeferPaintWidget, ElementList);
+	PaintFrame(DeferPaintWidget, ElementList);
+	const int32 NumPaintsBeforeInvalidation = Child->NumPaints;
+	DeferPaintWidget->InvalidateRetainedContent();
+	PaintFrame(DeferPaintWidget, ElementList);
+	PaintFrame(DeferPaintWidget, ElementList);
+	TestEqual(TEXT("Invalidated retained content is repainted once."), Child->NumPaints, NumPaintsBeforeInvalidation + 1);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,240 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "UIAdditionsPluginTestTypes.h"
+#include "HUDCore.h"
+#include "SubHUDWidget.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
+#include "UObject/Package.h"
+#include "TimerManager.h"
+#include "Misc/CoreDelegates.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDCoreEventDrivenTickTest, "UIAdditionsPlugin.HUD.EventDrivenTick", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHUDCoreEventDrivenTickTest::RunTest(const FString& InParameters) {
+	FUIAdditionsPluginTestWorld TestWorld;
+	ATestHUDCore* HUD = TestWorld.World->SpawnActor<ATestHUDCore>();
+	if (!TestNotNull(TEXT("The HUD spawned."), HUD)) {
+		return false;
+	}
+
+	// Idle cost audit: a disabled tick function is never scheduled and the end of frame hook is unbound, so an idle HUD does no work per frame.
+	HUD->SetEventDrivenTick(true);
+	TestFalse(TEXT("An idle event driven HUD does not tick."), HUD->IsActorTickEnabled());
+	TestFalse(TEXT("An idle HUD is not bound to the end of the frame."), FCoreDelegates::OnEndFrame.IsBoundToObject(HUD));
+
+	HUD->RequestUpdateInputMode();
+	HUD->RequestUpdateInputMode();
+	TestTrue(TEXT("A pending input mode update binds to the end of the frame."), FCoreDelegates::OnEndFrame.IsBoundToObject(HUD));
+	// The test world has no player controller to apply the input mode to, which is logged.
+	AddExpectedError(TEXT("requires a valid component of type HUDCorePlayerControllerComponent"), EAutomationExpectedErrorFlags::Contains, 1);
+	HUD->ActOnEndFrame();
+	TestFalse(TEXT("The end of frame hook unbinds once the update was applied."), FCoreDelegates::OnEndFrame.IsBoundToObject(HUD));
+
+	HUD->RequestTick(TEXT("Animation"));
+	TestTrue(TEXT("A tick request enables the tick."), HUD->IsActorTickEnabled());
+	HUD->RequestTick(TEXT("Transition"));
+	HUD->ReleaseTick(TEXT("Animation"));
+	TestTrue(TEXT("The HUD keeps ticking while any request remains."), HUD->IsActorTickEnabled());
+	HUD->ReleaseTick(TEXT("Transition"));
+	TestFalse(TEXT("The HUD stops ticking once all requests are released."), HUD->IsActorTickEnabled());
+
+	// AHUDCore::TickRequestFrozenMouse, which is private.
+	const FName FrozenMouse = TEXT("FrozenMouse");
+
+	// Without a game viewport the frozen cursor can not be synchronized, which is logged.
+	AddExpectedError(TEXT("Invalid GameViewportClient"), EAutomationExpectedErrorFlags::Contains, 1);
+	HUD->SetFreezeCursor(true);
+	TestTrue(TEXT("A frozen cursor requests a tick."), HUD->IsTickRequested(FrozenMouse) && HUD->IsActorTickEnabled());
+	HUD->SetFreezeCursor(false);
+	TestFalse(TEXT("Unfreezing the cursor releases its tick."), HUD->IsTickRequested(FrozenMouse) || HUD->IsActorTickEnabled());
+
+	HUD->SetEventDrivenTick(false);
+	TestTrue(TEXT("A HUD which is not event driven always ticks."), HUD->IsActorTickEnabled());
+
+	return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDCorePawnHUDPoolTest, "UIAdditionsPlugin.HUD.PawnHUDPool", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHUDCorePawnHUDPoolTest::RunTest(const FString& InParameters) {
+	FUIAdditionsPluginTestWorld TestWorld;
+	ATestHUDCore* HUD = TestWorld.World->SpawnActor<ATestHUDCore>();
+	APawn* PawnA = TestWorld.World->SpawnActor<APawn>();
+	APawn* PawnB = TestWorld.World->SpawnActor<APawn>();
+	if (!TestNotNull(TEXT("The HUD spawned."), HUD) || !TestNotNull(TEXT("The pawns spawned."), PawnB)) {
+		return false;
+	}
+	HUD->SetPoolPawnHUDs(true);
+	HUD->SetPawnHUDPoolSize(2);
+
+	const TSubclassOf<USubHUDWidget> WidgetClass = UTestSubHUDWidget::StaticClass();
+	UTestSubHUDWidget* PawnHUD1 = NewObject<UTestSubHUDWidget>(GetTransientPackage());
+	UTestSubHUDWidget* PawnHUD2 = NewObject<UTestSubHUDWidget>(GetTransientPackage());
+	UTestSubHUDWidget* PawnHUD3 = NewObject<UTestSubHUDWidget>(GetTransientPackage());
+	PawnHUD1->BindToPawn(PawnA);
+	PawnHUD1->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+
+	// Releasing unbinds and collapses the pawn HUD, and keeps it while the pool has room.
+	HUD->ReleasePawnHUD(PawnHUD1);
+	TestNull(TEXT("A released pawn HUD is unbound from its pawn."), PawnHUD1->GetBoundPawn());
+	TestEqual(TEXT("A released pawn HUD is collapsed."), PawnHUD1->GetVisibility(), ESlateVisibility::Collapsed);
+	HUD->ReleasePawnHUD(PawnHUD2);
+	HUD->ReleasePawnHUD(PawnHUD3);
+	TestEqual(TEXT("The pool does not grow beyond its size."), HUD->GetNumPooledPawnHUDs(WidgetClass), 2);
+
+	// Acquiring reuses the idle instances, no widget is constructed.
+	USubHUDWidget* AcquiredHUD1 = HUD->AcquirePawnHUD(WidgetClass);
+	USubHUDWidget* AcquiredHUD2 = HUD->AcquirePawnHUD(WidgetClass);
+	TestTrue(TEXT("Acquiring takes the pooled instances."), AcquiredHUD1 != AcquiredHUD2 && (AcquiredHUD1 == PawnHUD1 || AcquiredHUD1 == PawnHUD2) && (AcquiredHUD2 == PawnHUD1 || AcquiredHUD2 == PawnHUD2));
+	TestEqual(TEXT("The pool is empty after acquiring all instances."), HUD->GetNumPooledPawnHUDs(WidgetClass), 0);
+
+	// A pooled instance is rebound to another pawn.
+	AcquiredHUD1->BindToPawn(PawnB);
+	TestTrue(TEXT("An acquired pawn HUD is rebound to the new pawn."), AcquiredHUD1->GetBoundPawn() == PawnB);
+
+	// Shrinking the pool drops what exceeds the new size.
+	HUD->ReleasePawnHUD(AcquiredHUD1);
+	HUD->ReleasePawnHUD(AcquiredHUD2);
+	HUD->SetPawnHUDPoolSize(1);
+	TestEqual(TEXT("Shrinking the pool removes idle instances."), HUD->GetNumPooledPawnHUDs(WidgetClass), 1);
+
+	return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDCorePawnHUDPossessionTest, "UIAdditionsPlugin.HUD.PawnHUDPossession", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHUDCorePawnHUDPossessionTest::RunTest(const FString& InParameters) {
+	FUIAdditionsPluginTestWorld TestWorld;
+	APlayerController* PC = TestWorld.World->SpawnActor<APlayerController>();
+	if (!TestNotNull(TEXT("The player controller spawned."), PC)) {
+		return false;
+	}
+	// CreateWidget requires a player controller with a local player.
+	PC->Player = NewObject<ULocalPlayer>(GetTransientPackage());
+
+	FActorSpawnParameters HUDSpawnParameters;
+	HUDSpawnParameters.Owner = PC;
+	ATestHUDCore* HUD = TestWorld.World->SpawnActor<ATestHUDCore>(HUDSpawnParameters);
+	APawn* Pawn = TestWorld.World->SpawnActor<APawn>();
+	ATestPawn* PawnA = TestWorld.World->SpawnActor<ATestPawn>();
+	ATestVehiclePawn* PawnB = TestWorld.World->SpawnActor<ATestVehiclePawn>();
+	if (!TestNotNull(TEXT("The HUD spawned."), HUD) || !TestNotNull(TEXT("The pawns spawned."), PawnB)) {
+		return false;
+	}
+
+	// No default pawn HUD, so every pawn HUD of this test comes from an override.
+	TMap<TSoftClassPtr<APawn>, TSoftClassPtr<USubHUDWidget>> Overrides;
+	Overrides.Add(TSoftClassPtr<APawn>(ATestPawn::StaticClass()), TSoftClassPtr<USubHUDWidget>(UTestSubHUDWidget::StaticClass()));
+	Overrides.Add(TSoftClassPtr<APawn>(ATestVehiclePawn::StaticClass()), TSoftClassPtr<USubHUDWidget>(UTestVehicleSubHUDWidget::StaticClass()));
+	HUD->SetPawnHUDWidgetClasses(nullptr, Overrides);
+
+	TestNull(TEXT("A pawn without an override and without a default has no pawn HUD class."), HUD->GetPawnHUDWidgetClass(Pawn).Get());
+	TestTrue(TEXT("A pawn uses the override of its class."), HUD->GetPawnHUDWidgetClass(PawnA) == UTestSubHUDWidget::StaticClass());
+	TestTrue(TEXT("The most specific override wins over the override of a super class."), HUD->GetPawnHUDWidgetClass(PawnB) == UTestVehicleSubHUDWidget::StaticClass());
+
+	// Warmup constructs one idle pawn HUD per loaded class.
+	HUD->SetPoolPawnHUDs(true);
+	HUD->SetPawnHUDPoolSize(2);
+	HUD->SetPawnHUDPoolWarmupCount(1);
+	TestEqual(TEXT("Warmup constructs a pawn HUD per class."), HUD->NumCreatedPawnHUDs, 2);
+	TestEqual(TEXT("The pawn HUD pool is warm."), HUD->GetNumPooledPawnHUDs(UTestSubHUDWidget::StaticClass()), 1);
+	TestEqual(TEXT("The vehicle pawn HUD pool is warm."), HUD->GetNumPooledPawnHUDs(UTestVehicleSubHUDWidget::StaticClass()), 1);
+	const int32 NumWarmedPawnHUDs = HUD->NumCreatedPawnHUDs;
+
+	// Possess pawn A.
+	PC->SetPawn(PawnA);
+	PawnA->PossessedBy(PC);
+	HUD->ActOnControllerPawnChanged(PawnA);
+	USubHUDWidget* PawnHUDA = HUD->FindPawnHUD(PawnA);
+	TestTrue(TEXT("Pawn A has a pawn HUD of its class."), IsValid(PawnHUDA) && PawnHUDA->GetClass() == UTestSubHUDWidget::StaticClass());
+	TestTrue(TEXT("The pawn HUD of pawn A is bound and shown."), IsValid(PawnHUDA) && PawnHUDA->GetBoundPawn() == PawnA && PawnHUDA->GetVisibility() == ESlateVisibility::SelfHitTestInvisible);
+	TestEqual(TEXT("The pawn HUD of pawn A came from the pool."), HUD->GetNumPooledPawnHUDs(UTestSubHUDWidget::StaticClass()), 0);
+
+	// Unpossess pawn A, then possess pawn B.
+	PawnA->UnPossessed();
+	HUD->ActOnPawnControllerChanged(PawnA, nullptr);
+	TestNull(TEXT("The pawn HUD of an unpossessed pawn is released."), HUD->FindPawnHUD(PawnA));
+	TestEqual(TEXT("The released pawn HUD is back in the pool."), HUD->GetNumPooledPawnHUDs(UTestSubHUDWidget::StaticClass()), 1);
+
+	PC->SetPawn(PawnB);
+	PawnB->PossessedBy(PC);
+	HUD->ActOnControllerPawnChanged(PawnB);
+	USubHUDWidget* PawnHUDB = HUD->FindPawnHUD(PawnB);
+	TestTrue(TEXT("Pawn B has a pawn HUD of the most specific override."), IsValid(PawnHUDB) && PawnHUDB->GetClass() == UTestVehicleSubHUDWidget::StaticClass());
+	TestTrue(TEXT("The pawn HUD of pawn B is bound and shown."), IsValid(PawnHUDB) && PawnHUDB->GetBoundPawn() == PawnB && PawnHUDB->GetVisibility() == ESlateVisibility::SelfHitTestInvisible);
+	TestEqual(TEXT("Swapping possession constructed no widget."), HUD->NumCreatedPawnHUDs, NumWarmedPawnHUDs);
+
+	PawnB->UnPossessed();
+	HUD->ActOnPawnControllerChanged(PawnB, nullptr);
+	PC->SetPawn(nullptr);
+	PC->Player = nullptr;
+
+	return true;
+}
+
+
+
+/* Tests the startup timings of InHUD, once its startup completed. */
+static void TestStartupTimings(FAutomationTestBase& InTest, const ATestHUDCore* InHUD, bool bInAsyncStartup) {
+	const FS_HUDStartupTimings& Timings = InHUD->GetStartupTimings();
+	InTest.TestTrue(TEXT("The startup completed."), InHUD->GetIsStartupComplete());
+	InTest.TestEqual(TEXT("The startup reports whether it was async."), Timings.bWasAsync, bInAsyncStartup);
+	InTest.TestTrue(TEXT("Without widget classes to load, they count as preloaded."), Timings.bWasPreloaded);
+	InTest.TestTrue(TEXT("Phase timings are not negative."), Timings.LoadMs >= 0.f && Timings.ConstructMs >= 0.f && Timings.AttachMs >= 0.f);
+	// The total is measured over the phases, the phases are measured separately.
+	InTest.TestTrue(TEXT("The total covers all phases."), Timings.TotalMs + 0.01f >= Timings.LoadMs + Timings.ConstructMs + Timings.AttachMs);
+	InTest.TestTrue(TEXT("The total is measured from the start of this startup."), Timings.TotalMs < 10000.f);
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDCoreStartupTimingsTest, "UIAdditionsPlugin.HUD.StartupTimings", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHUDCoreStartupTimingsTest::RunTest(const FString& InParameters) {
+	FUIAdditionsPluginTestWorld TestWorld;
+	ATestHUDCore* HUD = TestWorld.World->SpawnActor<ATestHUDCore>();
+	if (!TestNotNull(TEXT("The HUD spawned."), HUD)) {
+		return false;
+	}
+	TestFalse(TEXT("The startup is not complete before it ran."), HUD->GetIsStartupComplete());
+
+	// Synchronous startup completes right away.
+	HUD->SetAsyncStartup(false, 0.f);
+	HUD->StartupLoadWidgetClasses();
+	TestStartupTimings(*this, HUD, false);
+	TestEqual(TEXT("Synchronous construction takes a single frame."), HUD->GetStartupTimings().ConstructFrames, 1);
+
+	// Async startup with everything preloaded does not wait for the streamable manager. Without a budget construction is not sliced.
+	HUD->SetAsyncStartup(true, 0.f);
+	HUD->StartupLoadWidgetClasses();
+	TestStartupTimings(*this, HUD, true);
+	TestEqual(TEXT("Construction without a budget takes a single frame."), HUD->GetStartupTimings().ConstructFrames, 1);
+
+	// Every step takes longer than the budget, so each frame constructs a single step.
+	HUD->SetAsyncStartup(true, 0.5f);
+	HUD->StartupConstructStepSeconds = 0.002f;
+	HUD->StartupLoadWidgetClasses();
+	TestFalse(TEXT("A sliced startup is not complete after its first frame."), HUD->GetIsStartupComplete());
+	// The world is not ticked, so the next frames are run directly instead of through the timer.
+	for (int32 i = 0; i < 16 && !HUD->GetIsStartupComplete(); i++) {
+		TestWorld.World->GetTimerManager().ClearAllTimersForObject(HUD);
+		HUD->StartupConstructWidgets();
+	}
+	TestWorld.World->GetTimerManager().ClearAllTimersForObject(HUD);
+	TestStartupTimings(*this, HUD, true);
+	TestTrue(TEXT("Construction over budget is sliced over multiple frames."), HUD->GetStartupTimings().ConstructFrames > 1);
+	HUD->StartupConstructStepSeconds = 0.f;
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "InteractableWidgetHitIndex.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformProcess.h"
+#include "Input/HittestGrid.h"
+#include "Layout/Geometry.h"
+#include "Misc/App.h"
+#include "Rendering/DrawElements.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SWindow.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+/* Hit test visible, non interactable leaf, like an image blocking the widgets below it. */
+class SHitIndexBlockingWidget : public SLeafWidget {
+
+public:
+
+	SLATE_BEGIN_ARGS(SHitIndexBlockingWidget) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs) {}
+
+	virtual FVector2D ComputeDesiredSize(float InLayoutScaleMultiplier) const override {
+		return FVector2D(32.f, 32.f);
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override {
+		return LayerId;
+	}
+
+};
+
+/* Paints InWidget into a 256 x 256 root, so its cached geometry and layers are up to date. */
+static void PaintHitIndexFrame(const TSharedRef<SWidget>& InWidget) {
+	const FVector2D Size(256.f, 256.f);
+	const FGeometry Geometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+	const FSlateRect CullingRect(0.f, 0.f, Size.X, Size.Y);
+	FHittestGrid HittestGrid;
+	FPaintArgs PaintArgs(nullptr, HittestGrid, FVector2D::ZeroVector, FApp::GetCurrentTime(), FApp::GetDeltaTime());
+
+	TSharedRef<SWindow> Window = SNew(SWindow);
+	FSlateWindowElementList ElementList(Window);
+	InWidget->SlatePrepass(1.f);
+	InWidget->Paint(PaintArgs, Geometry, CullingRect, ElementList, 0, FWidgetStyle(), true);
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInteractableWidgetHitIndexOcclusionTest, "UIAdditionsPlugin.Input.InteractableWidgetHitIndex.Occlusion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FInteractableWidgetHitIndexOcclusionTest::RunTest(const FString& InParameters) {
+	if (!FSlateApplication::IsInitialized()) {
+		AddWarning(TEXT("Slate is not initialized, skipped."));
+		return true;
+	}
+
+	// A button covering the root, with a blocking widget painted over its left 160 units.
+	TSharedRef<SButton> Button = SNew(SButton);
+	TSharedRef<SBox> BlockingBox = SNew(SBox)
+		.WidthOverride(160.f)
+		[
+			SNew(SHitIndexBlockingWidget)
+			.Visibility(EVisibility::Visible)
+		];
+	TSharedRef<SOverlay> Root = SNew(SOverlay)
+		+ SOverlay::Slot()
+		.HAlign(HAlign_Fill)
+		.VAlign(VAlign_Fill)
+		[Button]
+		+ SOverlay::Slot()
+		.HAlign(HAlign_Left)
+		.VAlign(VAlign_Fill)
+		[BlockingBox];
+	PaintHitIndexFrame(Root);
+
+	FInteractableWidgetHitIndex HitIndex;
+	HitIndex.SetRebuildInterval(0.f);
+	HitIndex.AddRoot(Root);
+	HitIndex.ConditionalRebuild();
+
+	TestFalse(TEXT("The button is not interactable where the blocking widget is painted on top of it."), HitIndex.IsInteractableAtPosition(FVector2D(64.f, 128.f)));
+	TestTrue(TEXT("The button is interactable where it is not occluded."), HitIndex.IsInteractableAtPosition(FVector2D(224.f, 128.f)));
+
+	FVector2D Center = FVector2D::ZeroVector;
+	TestFalse(TEXT("A button with an occluded center is not a snap target."), HitIndex.FindNearest(FVector2D(224.f, 128.f), 512.f, Center).IsValid());
+
+	// Hiding the blocking widget is a layout change the index picks up without being marked dirty.
+	BlockingBox->SetVisibility(EVisibility::Collapsed);
+	PaintHitIndexFrame(Root);
+	HitIndex.SetRebuildInterval(KINDA_SMALL_NUMBER);
+	FPlatformProcess::Sleep(0.01f);
+	HitIndex.ConditionalRebuild();
+
+	TestTrue(TEXT("The button is interactable once the blocking widget is hidden."), HitIndex.IsInteractableAtPosition(FVector2D(64.f, 128.f)));
+	TestTrue(TEXT("The button is a snap target once its center is no longer occluded."), HitIndex.FindNearest(FVector2D(64.f, 128.f), 512.f, Center) == TSharedPtr<SWidget>(Button));
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,150 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "UIAdditionsPluginTestTypes.h"
+#include "MenuWidget.h"
+#include "LazyWidget.h"
+#include "SlateUtils.h"
+#include "Blueprint/WidgetTree.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMenuWidgetInitializingParentMenuTest, "UIAdditionsPlugin.Menu.InitializingParentMenu", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FMenuWidgetInitializingParentMenuTest::RunTest(const FString& InParameters) {
+	UTestMenuWidget* ParentMenu = NewObject<UTestMenuWidget>(GetTransientPackage());
+	ParentMenu->WidgetTree = NewObject<UWidgetTree>(ParentMenu, TEXT("WidgetTree"), RF_Transient);
+	// Built by the parent menu, as if placed in its widget tree.
+	UTestMenuWidget* ChildMenu = NewObject<UTestMenuWidget>(ParentMenu->WidgetTree);
+	// Created while the parent menu initializes, but not part of its widget tree.
+	UTestMenuWidget* StrayMenu = NewObject<UTestMenuWidget>(GetTransientPackage());
+
+	bool bIsInitializingParentMenu = false;
+	uint32 NumAncestorWalks = UMenuWidget::GetNumAncestorWalks();
+
+	UMenuWidget::GetInitializingMenus().Push(ParentMenu);
+	{
+		TestTrue(TEXT("A widget built by the initializing menu finds it through the context."), UMenuWidget::FindParentMenu(ChildMenu, bIsInitializingParentMenu) == ParentMenu && bIsInitializingParentMenu);
+		TestEqual(TEXT("No ancestor walk for a widget built by the initializing menu."), UMenuWidget::GetNumAncestorWalks(), NumAncestorWalks);
+
+		TestNull(TEXT("A widget not built by the initializing menu does not trust the context."), UMenuWidget::FindInitializingParentMenu(StrayMenu));
+		TestNull(TEXT("A widget without menu ancestors has no parent menu."), UMenuWidget::FindParentMenu(StrayMenu, bIsInitializingParentMenu));
+		TestEqual(TEXT("A widget not built by the initializing menu walks the hierarchy."), UMenuWidget::GetNumAncestorWalks(), NumAncestorWalks + 1);
+
+		TestNull(TEXT("A menu is not its own initializing parent menu."), UMenuWidget::FindInitializingParentMenu(ParentMenu));
+	}
+	UMenuWidget::GetInitializingMenus().Pop(EAllowShrinking::No);
+
+	NumAncestorWalks = UMenuWidget::GetNumAncestorWalks();
+	TestTrue(TEXT("Without a context the parent menu is found by walking the hierarchy."), UMenuWidget::FindParentMenu(ChildMenu, bIsInitializingParentMenu) == ParentMenu && !bIsInitializingParentMenu);
+	TestEqual(TEXT("Without a context the hierarchy is walked once."), UMenuWidget::GetNumAncestorWalks(), NumAncestorWalks + 1);
+
+	// RegisterMenu only trusts the initializing parent menu if it built the registering menu.
+	StrayMenu->InitializingParentMenu = ParentMenu;
+	AddExpectedError(TEXT("not a child of this menu"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("A stray menu claiming an initializing parent menu is rejected."), ParentMenu->RegisterMenu(StrayMenu, TEXT("Stray")));
+
+	ChildMenu->InitializingParentMenu = ParentMenu;
+	TestTrue(TEXT("A menu built by the parent menu registers through the context."), ParentMenu->RegisterMenu(ChildMenu, TEXT("Child")));
+	ParentMenu->UnRegisterMenu(TEXT("Child"));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMenuWidgetVisibleMenusTest, "UIAdditionsPlugin.Menu.VisibleMenus", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FMenuWidgetVisibleMenusTest::RunTest(const FString& InParameters) {
+	UTestMenuWidget* ParentMenu = NewObject<UTestMenuWidget>(GetTransientPackage());
+	ParentMenu->WidgetTree = NewObject<UWidgetTree>(ParentMenu, TEXT("WidgetTree"), RF_Transient);
+	UTestMenuWidget* ChildMenu = NewObject<UTestMenuWidget>(ParentMenu->WidgetTree);
+	ParentMenu->SetVisibility(ESlateVisibility::Visible);
+
+	ChildMenu->InitializingParentMenu = ParentMenu;
+	TestTrue(TEXT("The child menu registers."), ParentMenu->RegisterMenu(ChildMenu, TEXT("Child")));
+	TestFalse(TEXT("A menu starts collapsed."), ParentMenu->IsAnyMenuVisible());
+
+	// Not through Show / Hide, which also broadcast OnMenuVisibilityChanged.
+	ChildMenu->SetVisibility(ESlateVisibility::Visible);
+	TestTrue(TEXT("A registered menu made visible through SetVisibility is visible."), ParentMenu->IsAnyMenuVisible());
+	TestTrue(TEXT("It is tracked without scanning the registered menus."), ParentMenu->VisibleMenus.Contains(ChildMenu));
+
+	ChildMenu->SetVisibility(ESlateVisibility::Collapsed);
+	TestFalse(TEXT("A registered menu collapsed through SetVisibility is not visible."), ParentMenu->IsAnyMenuVisible());
+
+	ChildMenu->Show();
+	TestTrue(TEXT("A registered menu shown through Show is visible."), ParentMenu->IsAnyMenuVisible());
+
+	ParentMenu->SetVisibility(ESlateVisibility::Collapsed);
+	TestFalse(TEXT("No menu is visible while the parent menu is collapsed."), ParentMenu->IsAnyMenuVisible());
+	ParentMenu->SetVisibility(ESlateVisibility::Visible);
+
+	ParentMenu->UnRegisterMenu(TEXT("Child"));
+	TestFalse(TEXT("An unregistered menu is no longer tracked."), ParentMenu->IsAnyMenuVisible());
+	ChildMenu->SetVisibility(ESlateVisibility::Collapsed);
+	ChildMenu->SetVisibility(ESlateVisibility::Visible);
+	TestFalse(TEXT("The visibility of an unregistered menu is no longer followed."), ParentMenu->IsAnyMenuVisible());
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMenuWidgetRoutePathTest, "UIAdditionsPlugin.Menu.RoutePath", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FMenuWidgetRoutePathTest::RunTest(const FString& InParameters) {
+	// Menus in a test have no owning player to focus.
+	AddExpectedError(TEXT("Got no valid owning local player"), EAutomationExpectedErrorFlags::Contains, 0);
+	AddExpectedError(TEXT("changed during NavigateToRoutePath"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("found no menu on route"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	// Root -> Settings -> Controls, built as if placed in each other's widget tree.
+	UTestMenuWidget* RootMenu = NewObject<UTestMenuWidget>(GetTransientPackage());
+	RootMenu->WidgetTree = NewObject<UWidgetTree>(RootMenu, TEXT("WidgetTree"), RF_Transient);
+	RootMenu->SetVisibility(ESlateVisibility::Visible);
+	UTestMenuWidget* SettingsMenu = NewObject<UTestMenuWidget>(RootMenu->WidgetTree);
+	SettingsMenu->WidgetTree = NewObject<UWidgetTree>(SettingsMenu, TEXT("WidgetTree"), RF_Transient);
+	UTestMenuWidget* ControlsMenu = NewObject<UTestMenuWidget>(SettingsMenu->WidgetTree);
+	SettingsMenu->InitializingParentMenu = RootMenu;
+	ControlsMenu->InitializingParentMenu = SettingsMenu;
+	TestTrue(TEXT("The settings menu registers."), RootMenu->RegisterMenu(SettingsMenu, TEXT("Settings")));
+	TestTrue(TEXT("The controls menu registers."), SettingsMenu->RegisterMenu(ControlsMenu, TEXT("Controls")));
+
+	E_RoutePathNavigationResults Result = E_RoutePathNavigationResults::Invalid;
+	TestTrue(TEXT("A valid path returns the menu on the last route."), RootMenu->NavigateToRoutePath({ TEXT("Settings"), TEXT("Controls") }, Result) == ControlsMenu);
+	TestTrue(TEXT("A valid path is navigated."), Result == E_RoutePathNavigationResults::Navigated);
+
+	// Closed by its parent the moment it is shown, the path is only active up to the settings menu.
+	RootMenu->NavigateToRoute(NAME_None);
+	SettingsMenu->NavigateToRoute(NAME_None);
+	ControlsMenu->bRequestCloseOnShow = true;
+	TestTrue(TEXT("An interrupted path returns the deepest menu it is active up to."), RootMenu->NavigateToRoutePath({ TEXT("Settings"), TEXT("Controls") }, Result) == SettingsMenu);
+	TestTrue(TEXT("An interrupted path is reported."), Result == E_RoutePathNavigationResults::Interrupted);
+	TestTrue(TEXT("The levels above the interruption are applied."), RootMenu->GetActiveRoute() == FName(TEXT("Settings")));
+	ControlsMenu->bRequestCloseOnShow = false;
+
+	TestNull(TEXT("A path through an unknown route is rejected."), RootMenu->NavigateToRoutePath({ TEXT("Settings"), TEXT("Audio") }, Result));
+	TestTrue(TEXT("A rejected path is reported as invalid."), Result == E_RoutePathNavigationResults::Invalid);
+
+	// The audio menu lives in lazy content of the settings menu, which is not loaded yet.
+	ULazyWidget* LazyWidget = SettingsMenu->WidgetTree->ConstructWidget<ULazyWidget>();
+	LazyWidget->SetLazyContent(TSoftClassPtr<UUserWidget>(FSoftObjectPath(TEXT("/Game/UIAdditionsPluginTests/WBP_Audio.WBP_Audio_C"))));
+	SettingsMenu->WidgetTree->RootWidget = LazyWidget;
+	TestTrue(TEXT("A path into unloaded lazy content returns the menu holding the content."), RootMenu->NavigateToRoutePath({ TEXT("Settings"), TEXT("Audio") }, Result) == SettingsMenu);
+	TestTrue(TEXT("A path into unloaded lazy content is pending."), Result == E_RoutePathNavigationResults::Pending);
+
+	// As if the lazy content loaded and the audio menu auto registered.
+	UTestMenuWidget* AudioMenu = NewObject<UTestMenuWidget>(SettingsMenu->WidgetTree);
+	AudioMenu->InitializingParentMenu = SettingsMenu;
+	TestTrue(TEXT("The audio menu registers."), SettingsMenu->RegisterMenu(AudioMenu, TEXT("Audio")));
+	TestTrue(TEXT("The pending path is navigated once the menu on it registers."), SettingsMenu->GetActiveRoute() == FName(TEXT("Audio")) && USlateUtils::IsVisible(AudioMenu->GetVisibility()));
+
+	SettingsMenu->UnRegisterMenu(TEXT("Audio"));
+	SettingsMenu->UnRegisterMenu(TEXT("Controls"));
+	RootMenu->UnRegisterMenu(TEXT("Settings"));
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
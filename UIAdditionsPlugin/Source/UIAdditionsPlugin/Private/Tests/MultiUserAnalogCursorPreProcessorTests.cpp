@@ -0,0 +1,69 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "MultiUserAnalogCursorPreProcessor.h"
+#include "ExtendedAnalogCursor.h"
+#include "Engine/LocalPlayer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+/* Analog cursor with an owner user index set by the test, instead of a local player's controller id. */
+class FTestExtendedAnalogCursor : public FExtendedAnalogCursor {
+
+public:
+
+	int32 TestOwnerUserIndex = INDEX_NONE;
+
+	FTestExtendedAnalogCursor(int32 InOwnerUserIndex)
+		: FExtendedAnalogCursor(FLocalPlayerContext()) {
+		TestOwnerUserIndex = InOwnerUserIndex;
+	}
+
+	virtual int32 GetOwnerUserIndex() const override {
+		return TestOwnerUserIndex;
+	}
+
+};
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiUserAnalogCursorPreProcessorRefileTest, "UIAdditionsPlugin.Input.MultiUserAnalogCursorPreProcessor.Refile", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FMultiUserAnalogCursorPreProcessorRefileTest::RunTest(const FString& InParameters) {
+	AddExpectedError(TEXT("collides with another cursor of that user"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("has no valid owner user index"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FMultiUserAnalogCursorPreProcessor PreProcessor;
+	const TSharedRef<FTestExtendedAnalogCursor> CursorA = MakeShared<FTestExtendedAnalogCursor>(0);
+	const TSharedRef<FTestExtendedAnalogCursor> CursorB = MakeShared<FTestExtendedAnalogCursor>(1);
+	PreProcessor.AddCursor(CursorA);
+	PreProcessor.AddCursor(CursorB);
+
+	// Remapped onto the slot of another cursor, which keeps it.
+	CursorB->TestOwnerUserIndex = 0;
+	PreProcessor.RefileCursors();
+	TestTrue(TEXT("The cursor already in its slot keeps it."), PreProcessor.FindCursor(0) == TSharedPtr<FExtendedAnalogCursor>(CursorA));
+	TestEqual(TEXT("The colliding cursor is kept unfiled."), PreProcessor.GetNumUnfiledCursors(), 1);
+	TestEqual(TEXT("No cursor is dropped."), PreProcessor.GetNumCursors(), 2);
+
+	// Refiling again while it still collides does not log again.
+	PreProcessor.RefileCursors();
+	TestEqual(TEXT("The colliding cursor stays unfiled."), PreProcessor.GetNumUnfiledCursors(), 1);
+
+	CursorB->TestOwnerUserIndex = 1;
+	PreProcessor.RefileCursors();
+	TestTrue(TEXT("The unfiled cursor is filed once its slot is free."), PreProcessor.FindCursor(1) == TSharedPtr<FExtendedAnalogCursor>(CursorB));
+	TestEqual(TEXT("No cursor is unfiled."), PreProcessor.GetNumUnfiledCursors(), 0);
+
+	CursorB->TestOwnerUserIndex = INDEX_NONE;
+	PreProcessor.RefileCursors();
+	TestFalse(TEXT("A cursor without a valid owner user index leaves its slot."), PreProcessor.FindCursor(1).IsValid());
+	TestEqual(TEXT("A cursor without a valid owner user index is kept unfiled."), PreProcessor.GetNumUnfiledCursors(), 1);
+
+	PreProcessor.RemoveCursor(CursorB);
+	TestEqual(TEXT("Removing an unfiled cursor removes it."), PreProcessor.GetNumCursors(), 1);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,69 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "Misc/AutomationTest.h"
+#include "MultiUserFocusChangeDispatcher.h"
+#include "Input/Events.h"
+#include "Layout/WidgetPath.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiUserFocusChangeDispatcherTest, "UIAdditionsPlugin.Input.MultiUserFocusChangeDispatcher", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FMultiUserFocusChangeDispatcherTest::RunTest(const FString& InParameters) {
+	FMultiUserFocusChangeDispatcher Dispatcher;
+	TArray<int32> NumNotified;
+	NumNotified.SetNumZeroed(4);
+
+	const auto MakeListener = [&NumNotified](int32 InUserIndex) {
+		return FOnUserFocusChanging::CreateLambda([&NumNotified, InUserIndex](const FFocusEvent&, const FWeakWidgetPath&, const TSharedPtr<SWidget>&, const FWidgetPath&, const TSharedPtr<SWidget>&) {
+			NumNotified[InUserIndex]++;
+		});
+	};
+	const auto ChangeFocus = [&Dispatcher](int32 InUserIndex) {
+		Dispatcher.ActOnFocusChanging(FFocusEvent(EFocusCause::SetDirectly, (uint32)InUserIndex), FWeakWidgetPath(), nullptr, FWidgetPath(), nullptr);
+	};
+
+	const FDelegateHandle HandleUser0 = Dispatcher.AddListener(0, MakeListener(0));
+	const FDelegateHandle HandleUser2 = Dispatcher.AddListener(2, MakeListener(2));
+	Dispatcher.AddListener(2, MakeListener(2));
+	TestEqual(TEXT("Listeners are stored per user."), Dispatcher.GetNumListeners(2), 2);
+	TestEqual(TEXT("A user without listeners has none."), Dispatcher.GetNumListeners(1), 0);
+
+	// A focus change only reaches the listeners of its user.
+	ChangeFocus(2);
+	TestEqual(TEXT("The listeners of the focusing user are notified."), NumNotified[2], 2);
+	TestEqual(TEXT("The listeners of other users are not notified."), NumNotified[0], 0);
+
+	ChangeFocus(1);
+	ChangeFocus(3);
+	TestEqual(TEXT("Focus changes of users without listeners reach nobody."), NumNotified[0] + NumNotified[1] + NumNotified[2] + NumNotified[3], 2);
+
+	ChangeFocus(0);
+	TestEqual(TEXT("User 0 is notified of its own focus change."), NumNotified[0], 1);
+
+	// Removing listeners.
+	Dispatcher.RemoveListener(2, HandleUser2);
+	TestEqual(TEXT("A removed listener is gone."), Dispatcher.GetNumListeners(2), 1);
+	Dispatcher.RemoveListener(0, HandleUser2);
+	TestEqual(TEXT("A handle only removes the listener of its own user."), Dispatcher.GetNumListeners(0), 1);
+	Dispatcher.RemoveListener(0, HandleUser0);
+	ChangeFocus(0);
+	TestEqual(TEXT("A removed listener is not notified."), NumNotified[0], 1);
+
+	// A listener may remove itself while being notified.
+	FDelegateHandle SelfRemovingHandle;
+	int32 NumSelfRemovingNotified = 0;
+	SelfRemovingHandle = Dispatcher.AddListener(1, FOnUserFocusChanging::CreateLambda([&Dispatcher, &SelfRemovingHandle, &NumSelfRemovingNotified](const FFocusEvent&, const FWeakWidgetPath&, const TSharedPtr<SWidget>&, const FWidgetPath&, const TSharedPtr<SWidget>&) {
+		NumSelfRemovingNotified++;
+		Dispatcher.RemoveListener(1, SelfRemovingHandle);
+	}));
+	ChangeFocus(1);
+	ChangeFocus(1);
+	TestEqual(TEXT("A listener removing itself is notified once."), NumSelfRemovingNotified, 1);
+	TestEqual(TEXT("A listener removing itself is gone."), Dispatcher.GetNumListeners(1), 0);
+
+	return true;
+}
+
+
+#endif // WITH_DEV_AUTOMATION_TESTS
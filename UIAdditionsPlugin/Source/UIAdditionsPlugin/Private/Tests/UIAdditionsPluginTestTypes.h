@@ -0,0 +1,179 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MenuWidget.h"
+#include "HUDCore.h"
+#include "SubHUDWidget.h"
+#include "CursorWidget.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Blueprint/UserWidget.h"
+#include "HAL/PlatformProcess.h"
+
+#include "UIAdditionsPluginTestTypes.generated.h"
+
+
+/* Concrete menu for automation tests, UMenuWidget itself is abstract. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UTestMenuWidget : public UMenuWidget {
+	GENERATED_BODY()
+
+protected:
+
+	virtual void NativeShow() override {
+		UMenuWidget::NativeShow();
+		if (bRequestCloseOnShow) {
+			RequestUINavigation(NAME_None);
+		}
+	}
+
+public:
+
+	/* Requests its parent menu to close it the moment it is shown. */
+	bool bRequestCloseOnShow = false;
+
+};
+
+
+/* Concrete sub HUD for automation tests, USubHUDWidget itself is abstract. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UTestSubHUDWidget : public USubHUDWidget {
+	GENERATED_BODY()
+
+};
+
+
+/* Sub HUD for automation tests, a pawn HUD class override. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UTestVehicleSubHUDWidget : public UTestSubHUDWidget {
+	GENERATED_BODY()
+
+};
+
+
+/* Pawn for automation tests, with a pawn HUD class override. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class ATestPawn : public APawn {
+	GENERATED_BODY()
+
+};
+
+
+/* Pawn for automation tests, a subclass of ATestPawn with a more specific pawn HUD class override. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class ATestVehiclePawn : public ATestPawn {
+	GENERATED_BODY()
+
+};
+
+
+/* HUD for automation tests, exposing the protected setup. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class ATestHUDCore : public AHUDCore {
+	GENERATED_BODY()
+
+protected:
+
+	/* A test world has no game viewport, so pawn HUDs are constructed but not added to the screen. */
+	virtual USubHUDWidget* CreatePawnHUD(TSubclassOf<USubHUDWidget> InWidgetClass) override {
+		if (!IsValid(InWidgetClass) || !IsValid(GetOwningPlayerController())) {
+			return nullptr;
+		}
+		NumCreatedPawnHUDs++;
+		return CreateWidget<USubHUDWidget>(GetOwningPlayerController(), InWidgetClass);
+	}
+
+	/* Construction steps take at least StartupConstructStepSeconds, so time slicing is deterministic. */
+	virtual bool StartupConstructWidget(int32 InStep) override {
+		if (StartupConstructStepSeconds > 0.f) {
+			FPlatformProcess::Sleep(StartupConstructStepSeconds);
+		}
+		return AHUDCore::StartupConstructWidget(InStep);
+	}
+
+public:
+
+	/* Pawn HUDs constructed, to tell reuse from construction. */
+	int32 NumCreatedPawnHUDs = 0;
+
+	float StartupConstructStepSeconds = 0.f;
+
+	void SetEventDrivenTick(bool bInEventDrivenTick) {
+		bEventDrivenTick = bInEventDrivenTick;
+		UpdateTickEnabled();
+	}
+
+	void SetFreezeCursor(bool bInFreezeCursor) {
+		SetFreezeCursorToCenterOfScreen(bInFreezeCursor);
+	}
+
+	void SetPoolPawnHUDs(bool bInPoolPawnHUDs) {
+		bPoolPawnHUDs = bInPoolPawnHUDs;
+	}
+
+	void SetAsyncStartup(bool bInAsyncStartup, float InStartupConstructionBudgetMs) {
+		bAsyncStartup = bInAsyncStartup;
+		StartupConstructionBudgetMs = InStartupConstructionBudgetMs;
+	}
+
+	void SetPawnHUDWidgetClasses(TSubclassOf<USubHUDWidget> InPawnHUDWidgetClass, const TMap<TSoftClassPtr<APawn>, TSoftClassPtr<USubHUDWidget>>& InPawnHUDWidgetClassOverrides) {
+		PawnHUDWidgetClass = TSoftClassPtr<USubHUDWidget>(InPawnHUDWidgetClass.Get());
+		PawnHUDWidgetClassOverrides = InPawnHUDWidgetClassOverrides;
+	}
+
+	using AHUDCore::StartupLoadWidgetClasses;
+
+	using AHUDCore::StartupConstructWidgets;
+
+	using AHUDCore::RequestUpdateInputMode;
+
+	using AHUDCore::ActOnEndFrame;
+
+	using AHUDCore::GetPawnHUDWidgetClass;
+
+	using AHUDCore::ActOnControllerPawnChanged;
+
+	using AHUDCore::ActOnPawnControllerChanged;
+
+	using AHUDCore::AcquirePawnHUD;
+
+	using AHUDCore::ReleasePawnHUD;
+
+};
+
+
+/* Concrete cursor for automation tests, exposing the end of frame hook. */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UTestCursorWidget : public UCursorWidget {
+	GENERATED_BODY()
+
+public:
+
+	using UCursorWidget::ActOnEndFrame;
+
+};
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* A game world for the duration of a test. Play is not started, so actors spawned in it do not run BeginPlay. */
+struct FUIAdditionsPluginTestWorld {
+
+	UWorld* World = nullptr;
+
+	FUIAdditionsPluginTestWorld() {
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+	}
+
+	~FUIAdditionsPluginTestWorld() {
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/Pawn.h"
 #include "SubHUDWidget.h"
+#include "HUDFocusPathResolver.h"
 #include "Engine/GameInstance.h"
 #include "CursorWidget.h"
 #include "DisabledCursorWidget.h"
@@ -11,6 +12,10 @@
 #include "WorldCursorModifierComponent.h"
 #include "Framework/Application/SlateApplication.h"
 #include "ExtendedAnalogCursor.h"
+#include "InteractableWidgetHitIndex.h"
+#include "MultiUserAnalogCursorPreProcessor.h"
+#include "UIAdditionsPlugin.h"
+#include "Modules/ModuleManager.h"
 #include "SlateUtils.h"
 #include "LogUIAdditionsPlugin.h"
 #include "Engine/GameViewportClient.h"
@@ -22,18 +27,202 @@
 #include "HUDCorePlayerControllerComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "UnrealClient.h"
+#include "Misc/CoreDelegates.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "TimerManager.h"
+#include "HAL/PlatformTime.h"
+#include "StatsUIAdditionsPlugin.h"
+#include "MultiUserFocusChangeDispatcher.h"
+#include "PlayerControllerCore.h"
 
 
+const FName AHUDCore::TickRequestFrozenMouse = FName("FrozenMouse");
+
 // Setup
 	
 void AHUDCore::BeginPlay() {
 	Super::BeginPlay();
+
+	// Blueprint tick logic can't announce when it has work, so it keeps the HUD ticking.
+	bHasScriptTick = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AHUDCore, ReceiveTick))
+		|| GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AHUDCore, TickUpdateMouseLocation));
+	UpdateTickEnabled();
+
+	// Start loading pooled pawn HUD classes before any pawn needs one. The async startup loads and warms them itself.
+	if (GetPoolPawnHUDs() && !bAsyncStartup) {
+		PreloadPawnHUDWidgetClasses();
+	}
 	
 	// Be notified when a pawn's controller changes so we can create a PawnHUD.
 	UGameInstance* GI = UGameplayStatics::GetGameInstance(this);
 	check(IsValid(GI));
 	GI->GetOnPawnControllerChanged().AddDynamic(this, &AHUDCore::ActOnPawnControllerChanged);
 
+	// Load, construct and attach the sub HUDs. Without bAsyncStartup this completes right here.
+	StartupLoadWidgetClasses();
+
+	// Slate delegates, focus changes of other players are not routed to this HUD.
+	RegisterFocusChangingListener();
+
+	// Viewport delegates, the freeze anchor depends on the player screen.
+	FViewport::ViewportResizedEvent.AddUObject(this, &AHUDCore::ActOnViewportResized);
+	UGameViewportClient* GameViewportClient = IsValid(GetWorld()) ? GetWorld()->GetGameViewport() : nullptr;
+	if (IsValid(GameViewportClient)) {
+		GameViewportClient->OnPlayerAdded().AddUObject(this, &AHUDCore::ActOnPlayerAddedOrRemoved);
+		GameViewportClient->OnPlayerRemoved().AddUObject(this, &AHUDCore::ActOnPlayerAddedOrRemoved);
+	}
+}
+
+void AHUDCore::EndPlay(const EEndPlayReason::Type InEndPlayReason) {
+	// The dispatcher outlives the world, a HUD waiting for garbage collection must not receive focus changes.
+	UnregisterFocusChangingListener();
+
+	Super::EndPlay(InEndPlayReason);
+}
+
+void AHUDCore::BeginDestroy() {
+	// Make sure to unregister the analog cursor from slate or it could remain there.
+	DisableAnalogCursor();
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameDelegateHandle);
+	EndFrameDelegateHandle.Reset();
+
+	Super::BeginDestroy();
+}
+
+// Startup
+
+TSharedPtr<FStreamableHandle> AHUDCore::PreloadHUDWidgetClasses(TSubclassOf<AHUDCore> InHUDClass) {
+	const AHUDCore* HUDDefaults = GetDefault<AHUDCore>(InHUDClass);
+	if (!IsValid(HUDDefaults)) {
+		return nullptr;
+	}
+	TArray<FSoftObjectPath> WidgetClassPaths;
+	HUDDefaults->GetHUDWidgetClassPaths(WidgetClassPaths);
+	if (WidgetClassPaths.Num() == 0) {
+		return nullptr;
+	}
+	UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Preloading %d sub HUD widget classes of %s."), WidgetClassPaths.Num(), *InHUDClass->GetName());
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+}
+
+void AHUDCore::GetHUDWidgetClassPaths(TArray<FSoftObjectPath>& OutWidgetClassPaths) const {
+	if (!PlayerScreenHUDWidgetClass.IsNull()) {
+		OutWidgetClassPaths.AddUnique(PlayerScreenHUDWidgetClass.ToSoftObjectPath());
+	}
+	if (!PlayerViewportHUDWidgetClass.IsNull()) {
+		OutWidgetClassPaths.AddUnique(PlayerViewportHUDWidgetClass.ToSoftObjectPath());
+	}
+	GetPawnHUDWidgetClassPaths(OutWidgetClassPaths);
+}
+
+void AHUDCore::GetPawnHUDWidgetClassPaths(TArray<FSoftObjectPath>& OutWidgetClassPaths) const {
+	if (!PawnHUDWidgetClass.IsNull()) {
+		OutWidgetClassPaths.AddUnique(PawnHUDWidgetClass.ToSoftObjectPath());
+	}
+	for (const TPair<TSoftClassPtr<APawn>, TSoftClassPtr<USubHUDWidget>>& OverrideX : PawnHUDWidgetClassOverrides) {
+		if (!OverrideX.Value.IsNull()) {
+			OutWidgetClassPaths.AddUnique(OverrideX.Value.ToSoftObjectPath());
+		}
+	}
+}
+
+void AHUDCore::StartupLoadWidgetClasses() {
+	bIsStartupComplete = false;
+	StartupTimings = FS_HUDStartupTimings();
+	StartupTimings.bWasAsync = bAsyncStartup;
+	StartupStartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> WidgetClassPaths;
+	GetHUDWidgetClassPaths(WidgetClassPaths);
+	StartupTimings.bWasPreloaded = true;
+	for (const FSoftObjectPath& PathX : WidgetClassPaths) {
+		if (!IsValid(PathX.ResolveObject())) {
+			StartupTimings.bWasPreloaded = false;
+			break;
+		}
+	}
+
+	if (!bAsyncStartup) {
+		// Pawn HUD classes are loaded when a pawn HUD is created.
+		PlayerScreenHUDWidgetClass.LoadSynchronous();
+		PlayerViewportHUDWidgetClass.LoadSynchronous();
+		ActOnStartupWidgetClassesLoaded();
+		return;
+	}
+	if (StartupTimings.bWasPreloaded) {
+		// Nothing to wait for, don't lose a frame on the streamable manager.
+		ActOnStartupWidgetClassesLoaded();
+		return;
+	}
+
+	TWeakObjectPtr<AHUDCore> WeakThis(this);
+	HUDWidgetClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPaths, [WeakThis]() {
+		AHUDCore* StrongThis = WeakThis.Get();
+		if (IsValid(StrongThis)) {
+			StrongThis->ActOnStartupWidgetClassesLoaded();
+		}
+	}, FStreamableManager::AsyncLoadHighPriority);
+}
+
+void AHUDCore::ActOnStartupWidgetClassesLoaded() {
+	StartupTimings.LoadMs = (float)((FPlatformTime::Seconds() - StartupStartTime) * 1000.0);
+	StartupConstructionStep = 0;
+	StartupConstructWidgets();
+}
+
+void AHUDCore::StartupConstructWidgets() {
+	const double SliceStartTime = FPlatformTime::Seconds();
+	const bool bIsTimeSliced = bAsyncStartup && StartupConstructionBudgetMs > 0.f;
+	StartupTimings.ConstructFrames++;
+
+	while (StartupConstructWidget(StartupConstructionStep)) {
+		StartupConstructionStep++;
+		const double SliceMs = (FPlatformTime::Seconds() - SliceStartTime) * 1000.0;
+		if (bIsTimeSliced && SliceMs >= StartupConstructionBudgetMs) {
+			StartupTimings.ConstructMs += (float)SliceMs;
+			GetWorldTimerManager().SetTimerForNextTick(this, &AHUDCore::StartupConstructWidgets);
+			return;
+		}
+	}
+
+	StartupTimings.ConstructMs += (float)((FPlatformTime::Seconds() - SliceStartTime) * 1000.0);
+	StartupAttachWidgets();
+}
+
+bool AHUDCore::StartupConstructWidget(int32 InStep) {
+	APlayerController* PC = GetOwningPlayerController();
+	switch (InStep) {
+		case 0:
+			if (IsValid(PlayerScreenHUDWidgetClass.Get())) {
+				PlayerScreenHUD = CreateWidget<USubHUDWidget>(PC, PlayerScreenHUDWidgetClass.Get());
+			}
+			return true;
+		case 1:
+			if (IsValid(PlayerViewportHUDWidgetClass.Get())) {
+				PlayerViewportHUD = CreateWidget<USubHUDWidget>(PC, PlayerViewportHUDWidgetClass.Get());
+			}
+			return true;
+		case 2:
+			// The pawn HUD of an already possessed pawn, so attaching does not construct it. While the pawn HUD classes preload, it is created once they are loaded.
+			if (IsValid(PC) && IsValid(PC->GetPawn()) && !IsPawnHUDPreloadPending()) {
+				FindOrCreatePawnHUD(PC->GetPawn());
+			}
+			return true;
+		case 3:
+			if (bAsyncStartup && GetPoolPawnHUDs()) {
+				WarmupPawnHUDPools();
+			}
+			return true;
+		default:
+			return false;
+	}
+}
+
+void AHUDCore::StartupAttachWidgets() {
+	const double AttachStartTime = FPlatformTime::Seconds();
+
 	// We can bind to a change in controller on the Pawn.
 	APlayerController* PC = GetOwningPlayerController();
 	if (IsValid(PC)) {
@@ -48,9 +237,7 @@ void AHUDCore::BeginPlay() {
 	}
 
 	// PlayerScreenHUD
-	if (IsValid(PlayerScreenHUDWidgetClass.LoadSynchronous())) {
-		PlayerScreenHUD = CreateWidget<USubHUDWidget>(GetOwningPlayerController(), PlayerScreenHUDWidgetClass.LoadSynchronous());
-		check(IsValid(GetPlayerScreenHUD()));
+	if (IsValid(GetPlayerScreenHUD())) {
 		GetPlayerScreenHUD()->AddToPlayerScreen(ZIndexPlayerScreenHUD);
 		GetPlayerScreenHUD()->OnMenuVisibilityChanged.AddDynamic(this, &AHUDCore::ActOnPlayerScreenHUDVisibilityChanged);
 		// Note that arguments are not used, so we can just directly call this to get updated state.
@@ -61,9 +248,7 @@ void AHUDCore::BeginPlay() {
 	}
 
 	// PlayerViewportHUD
-	if (IsValid(PlayerViewportHUDWidgetClass.LoadSynchronous())) {
-		PlayerViewportHUD = CreateWidget<USubHUDWidget>(GetOwningPlayerController(), PlayerViewportHUDWidgetClass.LoadSynchronous());
-		check(IsValid(GetPlayerViewportHUD()));
+	if (IsValid(GetPlayerViewportHUD())) {
 		GetPlayerViewportHUD()->AddToViewport(ZIndexPlayerViewportHUD);
 		GetPlayerViewportHUD()->OnMenuVisibilityChanged.AddDynamic(this, &AHUDCore::ActOnPlayerViewportHUDVisibilityChanged);
 		// Note that arguments are not used, so we can just directly call this to get updated state.
@@ -73,25 +258,90 @@ void AHUDCore::BeginPlay() {
 		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("PlayerViewportHUDWidgetClass not configured. Ignore if not required."));
 	}
 
-	// Slate delegates
-	FSlateApplication::Get().OnFocusChanging().AddUObject(this, &AHUDCore::ActOnFocusChanging);
+	UpdateInteractableWidgetHitIndexRoots();
+
+	const double EndTime = FPlatformTime::Seconds();
+	StartupTimings.AttachMs = (float)((EndTime - AttachStartTime) * 1000.0);
+	StartupTimings.TotalMs = (float)((EndTime - StartupStartTime) * 1000.0);
+	bIsStartupComplete = true;
+
+	// The sub HUDs hold their classes now, the startup load and the preload of the player controller are no longer needed. Pawn HUD classes are kept.
+	RetainLoadedPawnHUDWidgetClasses();
+	HUDWidgetClassesHandle.Reset();
+	APlayerControllerCore* PlayerControllerCore = Cast<APlayerControllerCore>(GetOwningPlayerController());
+	if (IsValid(PlayerControllerCore)) {
+		PlayerControllerCore->ReleasePreloadedHUDWidgetClasses();
+	}
+
+	// The stats are global, in split screen only the primary player reports to them. Every HUD logs and broadcasts its own timings.
+	const ULocalPlayer* LocalPlayer = IsValid(PC) ? PC->GetLocalPlayer() : nullptr;
+	if (!IsValid(LocalPlayer) || LocalPlayer->IsPrimaryPlayer()) {
+		SET_FLOAT_STAT(STAT_HUDStartup_LoadMs, StartupTimings.LoadMs);
+		SET_FLOAT_STAT(STAT_HUDStartup_ConstructMs, StartupTimings.ConstructMs);
+		SET_FLOAT_STAT(STAT_HUDStartup_AttachMs, StartupTimings.AttachMs);
+		SET_FLOAT_STAT(STAT_HUDStartup_TotalMs, StartupTimings.TotalMs);
+	}
+	UE_LOG(LogUIAdditionsPlugin, Log, TEXT("HUD startup of %s: Load %.2fms, Construct %.2fms over %d frames, Attach %.2fms, Total %.2fms (Async: %d, Preloaded: %d)."),
+		*GetName(), StartupTimings.LoadMs, StartupTimings.ConstructMs, StartupTimings.ConstructFrames, StartupTimings.AttachMs, StartupTimings.TotalMs, StartupTimings.bWasAsync, StartupTimings.bWasPreloaded);
+
+	OnHUDStartupCompleted.Broadcast(StartupTimings);
 }
 
-void AHUDCore::BeginDestroy() {
-	// Make sure to unregister the analog cursor from slate or it could remain there.
-	DisableAnalogCursor();
+void AHUDCore::RetainLoadedPawnHUDWidgetClasses() {
+	if (PawnHUDWidgetClassesHandle.IsValid()) {
+		// PreloadPawnHUDWidgetClasses holds them already.
+		return;
+	}
+	TArray<FSoftObjectPath> WidgetClassPaths;
+	GetPawnHUDWidgetClassPaths(WidgetClassPaths);
+	// Classes which are not loaded are left to GetPawnHUDWidgetClass, retaining must not start loading them.
+	WidgetClassPaths.RemoveAll([](const FSoftObjectPath& PathX) { return !IsValid(PathX.ResolveObject()); });
+	if (WidgetClassPaths.Num() == 0) {
+		return;
+	}
+	PawnHUDWidgetClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPaths, FStreamableDelegate());
+}
 
-	Super::BeginDestroy();
+bool AHUDCore::GetIsStartupComplete() const {
+	return bIsStartupComplete;
+}
+
+const FS_HUDStartupTimings& AHUDCore::GetStartupTimings() const {
+	return StartupTimings;
 }
 
 // Tick
 
 void AHUDCore::Tick(float InDeltaSeconds) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDCore_Tick);
+	INC_DWORD_STAT(STAT_HUDCore_Ticks);
+
 	Super::Tick(InDeltaSeconds);
 
 	TickUpdateMouseLocation();
 }
 
+void AHUDCore::UpdateTickEnabled() {
+	const bool bShouldTick = !bEventDrivenTick || bHasScriptTick || TickRequests.Num() > 0;
+	if (IsActorTickEnabled() != bShouldTick) {
+		SetActorTickEnabled(bShouldTick);
+	}
+}
+
+void AHUDCore::RequestTick(FName InReason) {
+	TickRequests.Add(InReason);
+	UpdateTickEnabled();
+}
+
+void AHUDCore::ReleaseTick(FName InReason) {
+	TickRequests.Remove(InReason);
+	UpdateTickEnabled();
+}
+
+bool AHUDCore::IsTickRequested(FName InReason) const {
+	return TickRequests.Contains(InReason);
+}
+
 void AHUDCore::TickUpdateMouseLocation_Implementation() {
 	/** 
 	* If we desire to freeze the cursor to the center of the screen but the analog cursor is not being used
@@ -123,8 +373,16 @@ void AHUDCore::TickUpdateMouseLocation_Implementation() {
 		return;
 	}
 
-	const FVector2D NewPosition = USlateUtils::GetCenterOfPlayerScreen(GameViewportClient, LocalPlayer);
-	PC->SetMouseLocation(NewPosition.X, NewPosition.Y);
+	if (!bIsMouseFreezeAnchorValid) {
+		MouseFreezeAnchor = USlateUtils::GetCenterOfPlayerScreen(GameViewportClient, LocalPlayer);
+		bIsMouseFreezeAnchorValid = true;
+	}
+	else if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetCursorPos().Equals(MouseFreezeAnchor, 1.f)) {
+		// The hardware cursor did not move away from the anchor, nothing to synchronize.
+		return;
+	}
+
+	PC->SetMouseLocation(MouseFreezeAnchor.X, MouseFreezeAnchor.Y);
 }
 
 // Panels
@@ -176,27 +434,174 @@ USubHUDWidget* AHUDCore::FindOrCreatePawnHUD(APawn* InPawn) {
 		// PawnHUD already exists
 		return PawnHUD;
 	}
-	// If it does not exist yet, create a PawnHUD.
+	// If it does not exist yet, create a PawnHUD, or take one from the pool.
 
-	if (IsValid(PawnHUDWidgetClass.LoadSynchronous())) {
-		PawnHUD = CreateWidget<USubHUDWidget>(GetOwningPlayerController(), PawnHUDWidgetClass.LoadSynchronous());
+	const TSubclassOf<USubHUDWidget> WidgetClass = GetPawnHUDWidgetClass(InPawn);
+	if (IsValid(WidgetClass)) {
+		PawnHUD = GetPoolPawnHUDs() ? AcquirePawnHUD(WidgetClass) : CreatePawnHUD(WidgetClass);
 		if (!IsValid(PawnHUD)) {
 			UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Invalid PawnHUD."));
 			return nullptr;
 		}
-		//PawnHUD->SetupOnCall(WidgetComponentRoot, InPawn);
+		PawnHUD->BindToPawn(InPawn);
 		PawnHUDs.Add(InPawn, PawnHUD);
-		PawnHUD->AddToPlayerScreen(ZIndexPawnHUD);
 		// Note that delegate bindings are not modified here, since they are only relevant based on possession.
 	}
 	else {
 		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("PawnHUDWidgetClass not configured. Ignore if not required."));
 	}
 
-	InPawn->OnDestroyed.AddDynamic(this, &AHUDCore::ActOnPawnDestroyed);
+	// Unique, a pooled pawn HUD is released on unpossession and the pawn can receive a new one later.
+	InPawn->OnDestroyed.AddUniqueDynamic(this, &AHUDCore::ActOnPawnDestroyed);
+	return PawnHUD;
+}
+
+TSubclassOf<USubHUDWidget> AHUDCore::GetPawnHUDWidgetClass(const APawn* InPawn) const {
+	TSoftClassPtr<USubHUDWidget> SoftWidgetClass = PawnHUDWidgetClass;
+	if (IsValid(InPawn) && PawnHUDWidgetClassOverrides.Num() > 0) {
+		// The most specific pawn class with an override wins.
+		for (UClass* ClassX = InPawn->GetClass(); IsValid(ClassX); ClassX = ClassX->GetSuperClass()) {
+			const TSoftClassPtr<USubHUDWidget>* OverrideX = PawnHUDWidgetClassOverrides.Find(TSoftClassPtr<APawn>(ClassX));
+			if (OverrideX) {
+				SoftWidgetClass = *OverrideX;
+				break;
+			}
+			if (ClassX == APawn::StaticClass()) {
+				break;
+			}
+		}
+	}
+
+	if (SoftWidgetClass.IsNull()) {
+		return nullptr;
+	}
+	if (!SoftWidgetClass.IsValid() && GetPoolPawnHUDs()) {
+		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Pawn HUD widget class %s was not preloaded yet. Loading synchronously."), *SoftWidgetClass.ToString());
+	}
+	return SoftWidgetClass.LoadSynchronous();
+}
+
+USubHUDWidget* AHUDCore::CreatePawnHUD(TSubclassOf<USubHUDWidget> InWidgetClass) {
+	if (!IsValid(InWidgetClass) || !IsValid(GetOwningPlayerController())) {
+		return nullptr;
+	}
+	USubHUDWidget* PawnHUD = CreateWidget<USubHUDWidget>(GetOwningPlayerController(), InWidgetClass);
+	if (IsValid(PawnHUD)) {
+		PawnHUD->AddToPlayerScreen(ZIndexPawnHUD);
+	}
 	return PawnHUD;
 }
 
+void AHUDCore::PreloadPawnHUDWidgetClasses() {
+	TArray<FSoftObjectPath> WidgetClassPaths;
+	GetPawnHUDWidgetClassPaths(WidgetClassPaths);
+	if (WidgetClassPaths.Num() == 0) {
+		return;
+	}
+
+	TWeakObjectPtr<AHUDCore> WeakThis(this);
+	PawnHUDWidgetClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPaths, [WeakThis]() {
+		AHUDCore* StrongThis = WeakThis.Get();
+		if (IsValid(StrongThis)) {
+			StrongThis->ActOnPawnHUDWidgetClassesPreloaded();
+		}
+	}, FStreamableManager::AsyncLoadHighPriority);
+}
+
+bool AHUDCore::IsPawnHUDPreloadPending() const {
+	return PawnHUDWidgetClassesHandle.IsValid() && PawnHUDWidgetClassesHandle->IsLoadingInProgress();
+}
+
+void AHUDCore::ActOnPawnHUDWidgetClassesPreloaded() {
+	WarmupPawnHUDPools();
+
+	if (!bIsStartupComplete) {
+		// The attach phase binds the possessed pawn itself.
+		return;
+	}
+	APlayerController* PC = GetOwningPlayerController();
+	APawn* Pawn = IsValid(PC) ? PC->GetPawn() : nullptr;
+	if (IsValid(Pawn) && !IsValid(FindPawnHUD(Pawn))) {
+		ShowPawnHUD(Pawn);
+		UpdateInteractableWidgetHitIndexRoots();
+	}
+}
+
+void AHUDCore::ShowPawnHUD(APawn* InPawn) {
+	USubHUDWidget* PawnHUD = FindOrCreatePawnHUD(InPawn);
+	if (IsValid(PawnHUD)) {
+		// Bind the delegate here, which is only relevant during possession.
+		PawnHUD->OnMenuVisibilityChanged.AddUniqueDynamic(this, &AHUDCore::ActOnPawnHUDVisibilityChanged);
+		// Show the PawnHUD
+		PawnHUD->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+		// Note that arguments are not used, so we can just directly call this to get updated state.
+		ActOnPawnHUDVisibilityChanged(nullptr, false);
+	}
+}
+
+void AHUDCore::WarmupPawnHUDPools() {
+	if (!GetPoolPawnHUDs()) {
+		return;
+	}
+
+	TArray<TSoftClassPtr<USubHUDWidget>, TInlineAllocator<8>> SoftWidgetClasses;
+	SoftWidgetClasses.AddUnique(PawnHUDWidgetClass);
+	for (const TPair<TSoftClassPtr<APawn>, TSoftClassPtr<USubHUDWidget>>& OverrideX : PawnHUDWidgetClassOverrides) {
+		SoftWidgetClasses.AddUnique(OverrideX.Value);
+	}
+
+	const int32 NumToWarm = FMath::Min(GetPawnHUDPoolWarmupCount(), GetPawnHUDPoolSize());
+	for (const TSoftClassPtr<USubHUDWidget>& SoftWidgetClassX : SoftWidgetClasses) {
+		// Only warm what is loaded, this must not cause a synchronous load.
+		UClass* WidgetClassX = SoftWidgetClassX.Get();
+		if (!IsValid(WidgetClassX)) {
+			continue;
+		}
+		FS_PawnHUDPool& Pool = PawnHUDPools.FindOrAdd(WidgetClassX);
+		while (Pool.Instances.Num() < NumToWarm) {
+			USubHUDWidget* PawnHUD = CreatePawnHUD(WidgetClassX);
+			if (!IsValid(PawnHUD)) {
+				break;
+			}
+			PawnHUD->SetVisibility(ESlateVisibility::Collapsed);
+			Pool.Instances.Add(PawnHUD);
+		}
+		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Warmed pawn HUD pool of %s: %d idle."), *WidgetClassX->GetName(), Pool.Instances.Num());
+	}
+}
+
+USubHUDWidget* AHUDCore::AcquirePawnHUD(TSubclassOf<USubHUDWidget> InWidgetClass) {
+	FS_PawnHUDPool* Pool = PawnHUDPools.Find(InWidgetClass);
+	if (Pool) {
+		while (Pool->Instances.Num() > 0) {
+			USubHUDWidget* PawnHUD = Pool->Instances.Pop(EAllowShrinking::No);
+			if (IsValid(PawnHUD)) {
+				return PawnHUD;
+			}
+		}
+	}
+	UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Pawn HUD pool of %s is empty. Creating a pawn HUD."), *GetNameSafe(InWidgetClass));
+	return CreatePawnHUD(InWidgetClass);
+}
+
+void AHUDCore::ReleasePawnHUD(USubHUDWidget* InPawnHUD) {
+	if (!IsValid(InPawnHUD)) {
+		return;
+	}
+	// A released pawn HUD must not report visibility changes to the HUD anymore.
+	InPawnHUD->OnMenuVisibilityChanged.RemoveDynamic(this, &AHUDCore::ActOnPawnHUDVisibilityChanged);
+	InPawnHUD->BindToPawn(nullptr);
+	InPawnHUD->SetVisibility(ESlateVisibility::Collapsed);
+
+	FS_PawnHUDPool& Pool = PawnHUDPools.FindOrAdd(InPawnHUD->GetClass());
+	if (Pool.Instances.Num() < GetPawnHUDPoolSize()) {
+		Pool.Instances.Add(InPawnHUD);
+	}
+	else {
+		InPawnHUD->RemoveFromParent();
+	}
+}
+
 void AHUDCore::DestroyPawnHUD(APawn* InPawn) {
 	if (!IsValid(InPawn)) {
 		return;
@@ -207,71 +612,142 @@ void AHUDCore::DestroyPawnHUD(APawn* InPawn) {
 	USubHUDWidget** PawnHUDPtr = PawnHUDs.Find(InPawn);
 	USubHUDWidget* PawnHUD = PawnHUDPtr ? *PawnHUDPtr : nullptr;
 	if (IsValid(PawnHUD)) {
-		PawnHUD->RemoveFromParent();
 		PawnHUDs.Remove(InPawn);
-		// Note that delegate bindings are not modified here, since they are only relevant based on possession.
+		if (GetPoolPawnHUDs()) {
+			ReleasePawnHUD(PawnHUD);
+		}
+		else {
+			PawnHUD->RemoveFromParent();
+			// Note that delegate bindings are not modified here, since they are only relevant based on possession.
+		}
+		UpdateInteractableWidgetHitIndexRoots();
+	}
+}
+
+bool AHUDCore::GetPoolPawnHUDs() const {
+	return bPoolPawnHUDs;
+}
+
+int32 AHUDCore::GetPawnHUDPoolSize() const {
+	return PawnHUDPoolSize;
+}
+
+void AHUDCore::SetPawnHUDPoolSize(int32 InPawnHUDPoolSize) {
+	PawnHUDPoolSize = FMath::Max(0, InPawnHUDPoolSize);
+	for (TPair<TSubclassOf<USubHUDWidget>, FS_PawnHUDPool>& PoolX : PawnHUDPools) {
+		while (PoolX.Value.Instances.Num() > GetPawnHUDPoolSize()) {
+			USubHUDWidget* PawnHUD = PoolX.Value.Instances.Pop();
+			if (IsValid(PawnHUD)) {
+				PawnHUD->RemoveFromParent();
+			}
+		}
 	}
 }
 
+int32 AHUDCore::GetPawnHUDPoolWarmupCount() const {
+	return PawnHUDPoolWarmupCount;
+}
+
+void AHUDCore::SetPawnHUDPoolWarmupCount(int32 InPawnHUDPoolWarmupCount) {
+	PawnHUDPoolWarmupCount = FMath::Max(0, InPawnHUDPoolWarmupCount);
+	WarmupPawnHUDPools();
+}
+
+int32 AHUDCore::GetNumPooledPawnHUDs(TSubclassOf<USubHUDWidget> InWidgetClass) const {
+	const FS_PawnHUDPool* Pool = PawnHUDPools.Find(InWidgetClass);
+	return Pool ? Pool->Instances.Num() : 0;
+}
+
 // Input
 
 void AHUDCore::UpdateInputMode() {
-	APlayerController* PC = GetOwningPlayerController();
-	if (!IsValid(PC)) {
-		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Can not update the current input mode without a valid owning player controller."));
-		return;
-	}	
-
-	UHUDCorePlayerControllerComponent* HUDCorePCComponent = PC->FindComponentByClass<UHUDCorePlayerControllerComponent>();
+	UHUDCorePlayerControllerComponent* HUDCorePCComponent = GetHUDCorePlayerControllerComponent();
 	if (!IsValid(HUDCorePCComponent)) {
 		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("To update the input mode, the PlayerController requires a valid component of type HUDCorePlayerControllerComponent."));
 		return;
 	}
 
+	E_PlayerControllerInputModes DesiredInputMode = E_PlayerControllerInputModes::Game;
+	bool bDesiresFreezeCursorToCenterOfScreen = false;
+
 	if (GetIsAnyPlayerViewportHUDMenuVisible() || GetIsAnyPlayerScreenHUDMenuVisible()) {
-		HUDCorePCComponent->ActivateInputMode(E_PlayerControllerInputModes::UI);
-		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("PlayerScreenHUD or PlayerViewportHUD has visible menu panels and desires the cursor to be unfrozen. Input mode set to 'UI'."));
-		SetFreezeCursorToCenterOfScreen(false);
+		DesiredInputMode = E_PlayerControllerInputModes::UI;
+		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("PlayerScreenHUD or PlayerViewportHUD has visible menu panels and desires the cursor to be unfrozen. Input mode 'UI'."));
 	}
 	else if (GetIsAnyPawnHUDMenuVisible()) {
-		HUDCorePCComponent->ActivateInputMode(E_PlayerControllerInputModes::GameAndUI);
-		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("PawnHUD has visible menu panels and desires the cursor to be unfrozen. Input mode set to 'Game + UI'."));
-		SetFreezeCursorToCenterOfScreen(false);
+		DesiredInputMode = E_PlayerControllerInputModes::GameAndUI;
+		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("PawnHUD has visible menu panels and desires the cursor to be unfrozen. Input mode 'Game + UI'."));
 	}
 	else {
-		HUDCorePCComponent->ActivateInputMode(E_PlayerControllerInputModes::Game);
-		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("No Sub HUD has a visible menu, the cursor does not have to be unfrozen. Input mode set to 'Game'."));
+		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("No Sub HUD has a visible menu, the cursor does not have to be unfrozen. Input mode 'Game'."));
+		// The pawn may desire the cursor to be frozen to center of screen (World Cursor Modifier Component). This is allowed in input mode 'Game'.
+		bDesiresFreezeCursorToCenterOfScreen = GetPawnDesiresCenteredWorldCursor();
+	}
 
-		if (GetPawnDesiresCenteredWorldCursor()) {
-			UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("The pawn desires the cursor to be frozen to center of screen (World Cursor Modifier Component). This is allowed in input mode 'Game'."));
-			SetFreezeCursorToCenterOfScreen(true);
-		}
-		else {
-			UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Unfreezing cursor from center of screen."));
-			SetFreezeCursorToCenterOfScreen(false);
-		}
+	// SetInputMode flushes pressed keys and can recapture the mouse, so it is only applied when the mode actually changes.
+	if (AppliedInputModeComponent.Get() != HUDCorePCComponent || !AppliedInputMode.IsSet() || AppliedInputMode.GetValue() != DesiredInputMode) {
+		HUDCorePCComponent->ActivateInputMode(DesiredInputMode);
+		AppliedInputMode = DesiredInputMode;
+		AppliedInputModeComponent = HUDCorePCComponent;
+	}
+	if (!bHasAppliedInputMode || GetFreezeCursorToCenterOfScreen() != bDesiresFreezeCursorToCenterOfScreen) {
+		SetFreezeCursorToCenterOfScreen(bDesiresFreezeCursorToCenterOfScreen);
+	}
+	bHasAppliedInputMode = true;
+}
+
+void AHUDCore::RequestUpdateInputMode() {
+	bIsInputModeDirty = true;
+	// Only bound while there is work, an idle HUD costs nothing at the end of the frame.
+	if (!EndFrameDelegateHandle.IsValid()) {
+		EndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &AHUDCore::ActOnEndFrame);
+	}
+}
+
+UHUDCorePlayerControllerComponent* AHUDCore::GetHUDCorePlayerControllerComponent() {
+	APlayerController* PC = GetOwningPlayerController();
+	if (!IsValid(PC)) {
+		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Can not find the HUDCorePlayerControllerComponent without a valid owning player controller."));
+		return nullptr;
+	}
+	if (!CachedHUDCorePlayerControllerComponent.IsValid() || CachedHUDCorePlayerControllerComponent->GetOwner() != PC) {
+		CachedHUDCorePlayerControllerComponent = PC->FindComponentByClass<UHUDCorePlayerControllerComponent>();
+	}
+	return CachedHUDCorePlayerControllerComponent.Get();
+}
+
+void AHUDCore::UpdateCursorContexts() {
+	if (!IsValid(GetCustomCursorWidget())) {
+		return;
 	}
+	// I intentionally did not move this context logic to the cursor itself (as observer). 
+	// It is only aware of its own context list and any implementation is up to the cursor.
+	GetCustomCursorWidget()->BeginCursorContextBatch();
+	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnDesiresCenteredWorldCursor"), GetPawnDesiresCenteredWorldCursor());
+	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerScreenHUDMenuVisible"), GetIsAnyPlayerScreenHUDMenuVisible());
+	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerViewportHUDMenuVisible"), GetIsAnyPlayerViewportHUDMenuVisible());
+	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnHUDMenuVisible"), GetIsAnyPawnHUDMenuVisible());
+	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("AnySubHUDMenuVisible"), IsAnySubHUDVisible());
+	GetCustomCursorWidget()->CommitCursorContextBatch();
 }
 
 // Delegates | Panels
 
 void AHUDCore::ActOnPlayerScreenHUDVisibilityChanged(UMenuWidget* InMenu, bool bIsVisible) {
 	bIsAnyPlayerScreenHUDMenuVisible = IsValid(GetPlayerScreenHUD()) && GetPlayerScreenHUD()->IsAnyMenuVisible();
-	UpdateInputMode();
+	RequestUpdateInputMode();
 
-	if (IsValid(GetCustomCursorWidget())) {
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerScreenHUDMenuVisible"), GetIsAnyPlayerScreenHUDMenuVisible());
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("AnySubHUDMenuVisible"), IsAnySubHUDVisible());
+	if (InteractableWidgetHitIndex.IsValid()) {
+		InteractableWidgetHitIndex->MarkDirty();
 	}
 }
 
 void AHUDCore::ActOnPlayerViewportHUDVisibilityChanged(UMenuWidget* InMenu, bool bIsVisible) {
-	bIsAnyPlayerViewportHUDMenuVisible = IsValid(GetPlayerViewportHUD()) && GetPlayerViewportHUD()->IsAnyMenuVisible();;
-	UpdateInputMode();
+	bIsAnyPlayerViewportHUDMenuVisible = IsValid(GetPlayerViewportHUD()) && GetPlayerViewportHUD()->IsAnyMenuVisible();
+	RequestUpdateInputMode();
 
-	if (IsValid(GetCustomCursorWidget())) {
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerViewportHUDMenuVisible"), GetIsAnyPlayerViewportHUDMenuVisible());
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("AnySubHUDMenuVisible"), IsAnySubHUDVisible());
+	if (InteractableWidgetHitIndex.IsValid()) {
+		InteractableWidgetHitIndex->MarkDirty();
 	}
 }
 
@@ -280,11 +756,10 @@ void AHUDCore::ActOnPawnHUDVisibilityChanged(UMenuWidget* InMenu, bool bIsVisibl
 	APawn* Pawn = IsValid(PC) ? PC->GetPawn() : nullptr;
 	USubHUDWidget* PawnHUD = FindPawnHUD(Pawn);
 	bIsAnyPawnHUDMenuVisible = IsValid(PawnHUD) && PawnHUD->IsAnyMenuVisible();
-	UpdateInputMode();
+	RequestUpdateInputMode();
 
-	if (IsValid(GetCustomCursorWidget())) {
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnHUDMenuVisible"), GetIsAnyPawnHUDMenuVisible());
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("AnySubHUDMenuVisible"), IsAnySubHUDVisible());
+	if (InteractableWidgetHitIndex.IsValid()) {
+		InteractableWidgetHitIndex->MarkDirty();
 	}
 }
 
@@ -321,7 +796,12 @@ void AHUDCore::ActOnPawnControllerChanged(APawn* InPawn, AController* InControll
 			PawnHUD->OnMenuVisibilityChanged.RemoveDynamic(this, &AHUDCore::ActOnPawnHUDVisibilityChanged);
 			// Note that arguments are not used, so we can just directly call this to get updated state.
 			ActOnPawnHUDVisibilityChanged(nullptr, false);
+			// Pooled pawn HUDs go back to the pool, so a possession change does not keep an instance per pawn.
+			if (GetPoolPawnHUDs()) {
+				DestroyPawnHUD(InPawn);
+			}
 		}
+		UpdateInteractableWidgetHitIndexRoots();
 	}
 }
 
@@ -347,15 +827,14 @@ void AHUDCore::ActOnControllerPawnChanged(APawn* InPawn) {
 		ActOnPawnDesiresCenteredWorldCursorChanged(true);
 	}
 
-	USubHUDWidget* PawnHUD = FindOrCreatePawnHUD(InPawn);
-	if (IsValid(PawnHUD)) {
-		// Bind the delegate here, which is only relevant during possession.
-		PawnHUD->OnMenuVisibilityChanged.AddDynamic(this, &AHUDCore::ActOnPawnHUDVisibilityChanged);
-		// Show the PawnHUD
-		PawnHUD->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
-		// Note that arguments are not used, so we can just directly call this to get updated state.
-		ActOnPawnHUDVisibilityChanged(nullptr, false);
+	if (IsPawnHUDPreloadPending()) {
+		// Creating the pawn HUD now would load its class synchronously. ActOnPawnHUDWidgetClassesPreloaded shows it.
+		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("Deferring the pawn HUD of %s until the pawn HUD widget classes are preloaded."), *InPawn->GetName());
 	}
+	else {
+		ShowPawnHUD(InPawn);
+	}
+	UpdateInteractableWidgetHitIndexRoots();
 }
 
 void AHUDCore::ActOnPawnDestroyed(AActor* InDestroyedActor) {
@@ -367,11 +846,43 @@ void AHUDCore::ActOnPawnDestroyed(AActor* InDestroyedActor) {
 
 void AHUDCore::ActOnPawnDesiresCenteredWorldCursorChanged(bool InPawnDesiresCenteredWorldCursor) {
 	bPawnDesiresCenteredWorldCursor = InPawnDesiresCenteredWorldCursor;
+	RequestUpdateInputMode();
+}
 
-	if (IsValid(GetCustomCursorWidget())) {
-		GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnDesiresCenteredWorldCursor"), GetPawnDesiresCenteredWorldCursor());
-		UpdateInputMode();
+// Focus
+
+void AHUDCore::RegisterFocusChangingListener() {
+	const int32 UserIndex = USlateUtils::GetSlateUserIndexForPlayerController(GetOwningPlayerController());
+	if (FocusChangingListenerHandle.IsValid() && UserIndex == FocusChangingListenerUserIndex) {
+		return;
+	}
+	UnregisterFocusChangingListener();
+	if (UserIndex == INDEX_NONE) {
+		UE_LOG(LogUIAdditionsPlugin, Verbose, TEXT("No Slate user for the owning player. Can't listen to focus changes."));
+		return;
+	}
+
+	const FUIAdditionsPluginModule& UIAdditionsPluginModule = FModuleManager::GetModuleChecked<FUIAdditionsPluginModule>(TEXT("UIAdditionsPlugin"));
+	const TSharedPtr<FMultiUserFocusChangeDispatcher>& FocusChangeDispatcher = UIAdditionsPluginModule.GetMultiUserFocusChangeDispatcher();
+	if (!FocusChangeDispatcher.IsValid()) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Invalid MultiUserFocusChangeDispatcher."));
+		return;
+	}
+	FocusChangingListenerHandle = FocusChangeDispatcher->AddListener(UserIndex, FOnUserFocusChanging::CreateUObject(this, &AHUDCore::ActOnFocusChanging));
+	FocusChangingListenerUserIndex = UserIndex;
+}
+
+void AHUDCore::UnregisterFocusChangingListener() {
+	if (!FocusChangingListenerHandle.IsValid()) {
+		return;
+	}
+	// The module can already be unloaded while the HUD is garbage collected on shutdown.
+	FUIAdditionsPluginModule* UIAdditionsPluginModule = FModuleManager::GetModulePtr<FUIAdditionsPluginModule>(TEXT("UIAdditionsPlugin"));
+	if (UIAdditionsPluginModule && UIAdditionsPluginModule->GetMultiUserFocusChangeDispatcher().IsValid()) {
+		UIAdditionsPluginModule->GetMultiUserFocusChangeDispatcher()->RemoveListener(FocusChangingListenerUserIndex, FocusChangingListenerHandle);
 	}
+	FocusChangingListenerHandle.Reset();
+	FocusChangingListenerUserIndex = INDEX_NONE;
 }
 
 // Delegates
@@ -387,8 +898,7 @@ void AHUDCore::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWi
 	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("HUD detects focus change. Reason: %s, New path: %s"), *UEnum::GetValueAsString(InFocusEvent.GetCause()), (InNewFocusedWidget.IsValid() ? *InNewFocusedWidget->ToString() : TEXT("null")));
 
 	// Guard against re entry, otherwise SomeMenu->RestoreFocus is going to be trouble.
-	static bool bIsEntered = false;
-	if (bIsEntered) {
+	if (bIsRestoringFocus) {
 		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Hit re entry guard."));
 		return;
 	}
@@ -396,6 +906,7 @@ void AHUDCore::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWi
 	USubHUDWidget* ViewportHUD = GetPlayerViewportHUD();
 	USubHUDWidget* ScreenHUD = GetPlayerScreenHUD();
 	USubHUDWidget* PawnHUD = FindPawnHUD(GetOwningPawn());
+	const FHUDFocusPathResolver FocusPathResolver(ViewportHUD, ScreenHUD, PawnHUD);
 
 	bool bNeedRestore = false;
 
@@ -423,12 +934,7 @@ void AHUDCore::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWi
 #endif // WITH_EDITOR
 
 	if (!bNeedRestore) {
-		bool bFoundValidNewPath = (
-			(IsValid(ViewportHUD) && InNewFocusedWidgetPath.ContainsWidget(&ViewportHUD->TakeWidget().Get()))
-			|| (IsValid(ScreenHUD) && InNewFocusedWidgetPath.ContainsWidget(&ScreenHUD->TakeWidget().Get()))
-			|| (IsValid(PawnHUD) && InNewFocusedWidgetPath.ContainsWidget(&PawnHUD->TakeWidget().Get()))
-			);
-		if (!bFoundValidNewPath) {
+		if (!FocusPathResolver.Resolve(InNewFocusedWidgetPath).ContainsAnyHUD()) {
 			UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Undesired focus loss (new path != on a sub HUD)."));
 			bNeedRestore = true;
 		}
@@ -439,16 +945,15 @@ void AHUDCore::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWi
 	}
 
 	USubHUDWidget* RestoreToWidget = nullptr;
-	if (InOldFocusedWidgetPath.IsValid()) {
-		if (IsValid(ViewportHUD) && InOldFocusedWidgetPath.ContainsWidget(&ViewportHUD->TakeWidget().Get())) {
-			RestoreToWidget = ViewportHUD;
-		}
-		else if (IsValid(ScreenHUD) && InOldFocusedWidgetPath.ContainsWidget(&ScreenHUD->TakeWidget().Get())) {
-			RestoreToWidget = ScreenHUD;
-		}
-		else if (IsValid(PawnHUD) && InOldFocusedWidgetPath.ContainsWidget(&PawnHUD->TakeWidget().Get())) {
-			RestoreToWidget = ScreenHUD;
-		}
+	const FHUDFocusPathLayers OldPathLayers = FocusPathResolver.Resolve(InOldFocusedWidgetPath);
+	if (OldPathLayers.bContainsViewportHUD) {
+		RestoreToWidget = ViewportHUD;
+	}
+	else if (OldPathLayers.bContainsScreenHUD) {
+		RestoreToWidget = ScreenHUD;
+	}
+	else if (OldPathLayers.bContainsPawnHUD) {
+		RestoreToWidget = PawnHUD;
 	}
 
 	// If the sub HUD has no visible menu, it has nothing for the user to interact with and we can assume that the focus changed from a submenu to nothing. Ignore?
@@ -478,13 +983,41 @@ void AHUDCore::ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWi
 	}
 
 	if (IsValid(RestoreToWidget)) {
-		bIsEntered = true;
+		bIsRestoringFocus = true;
 		////
 		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Attempts to restore focus to a visible sub HUD: %s."), *RestoreToWidget->GetName());
 		RestoreToWidget->RestoreFocus();
 		////
-		bIsEntered = false;
+		bIsRestoringFocus = false;
+	}
+}
+
+void AHUDCore::ActOnViewportResized(FViewport* InViewport, uint32 InUnused) {
+	InvalidateMouseFreezeAnchor();
+}
+
+void AHUDCore::ActOnPlayerAddedOrRemoved(int32 InPlayerIndex) {
+	InvalidateMouseFreezeAnchor();
+	// Controller ids can be remapped when players join or leave.
+	RegisterFocusChangingListener();
+	if (IsAnalogCursorValid()) {
+		const FUIAdditionsPluginModule& UIAdditionsPluginModule = FModuleManager::GetModuleChecked<FUIAdditionsPluginModule>(TEXT("UIAdditionsPlugin"));
+		const TSharedPtr<FMultiUserAnalogCursorPreProcessor>& MultiUserProcessor = UIAdditionsPluginModule.GetMultiUserAnalogCursorPreProcessor();
+		if (MultiUserProcessor.IsValid()) {
+			MultiUserProcessor->RefileCursors();
+		}
+	}
+}
+
+void AHUDCore::ActOnEndFrame() {
+	FCoreDelegates::OnEndFrame.Remove(EndFrameDelegateHandle);
+	EndFrameDelegateHandle.Reset();
+	if (!bIsInputModeDirty) {
+		return;
 	}
+	bIsInputModeDirty = false;
+	UpdateCursorContexts();
+	UpdateInputMode();
 }
 
 // Cursor
@@ -519,8 +1052,33 @@ void AHUDCore::EnableAnalogCursor() {
 		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("analog cursor is invalid."));
 		return;
 	}
+	if (GetAnalogCursor()->GetOwnerUserIndex() == INDEX_NONE) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Can not enable the analog cursor, it has no owner user index."));
+		AnalogCursor.Reset();
+		return;
+	}
+
+	GetAnalogCursor()->SetFixedStepRate(CursorIntegrationStepRate);
+	GetAnalogCursor()->SetUseFixedStepIntegration(bUseFixedStepCursorIntegration);
 
-	FSlateApplication::Get().RegisterInputPreProcessor(GetAnalogCursor());
+	if (bUseInteractableWidgetHitIndex) {
+		InteractableWidgetHitIndex = MakeShared<FInteractableWidgetHitIndex>();
+		InteractableWidgetHitIndex->SetRebuildInterval(InteractableWidgetHitIndexRebuildInterval);
+		UpdateInteractableWidgetHitIndexRoots();
+		GetAnalogCursor()->SetInteractableWidgetHitIndex(InteractableWidgetHitIndex);
+		GetAnalogCursor()->SetMagnetismStrength(CursorMagnetismStrength);
+		GetAnalogCursor()->SetMagnetismRadius(CursorMagnetismRadius);
+	}
+
+	const FUIAdditionsPluginModule& UIAdditionsPluginModule = FModuleManager::GetModuleChecked<FUIAdditionsPluginModule>(TEXT("UIAdditionsPlugin"));
+	const TSharedPtr<FMultiUserAnalogCursorPreProcessor>& MultiUserProcessor = UIAdditionsPluginModule.GetMultiUserAnalogCursorPreProcessor();
+	if (MultiUserProcessor.IsValid()) {
+		MultiUserProcessor->AddCursor(GetAnalogCursor().ToSharedRef());
+	}
+	else {
+		// The module could not register its preprocessors if Slate was not initialized during startup.
+		FSlateApplication::Get().RegisterInputPreProcessor(GetAnalogCursor());
+	}
 	// This freezes the actual virtual cursor to a position.
 	GetAnalogCursor()->SetFreezeCursorToCenterOfScreen(GetFreezeCursorToCenterOfScreen());
 }
@@ -535,8 +1093,17 @@ void AHUDCore::DisableAnalogCursor() {
 		return;
 	}
 
-	FSlateApplication::Get().UnregisterInputPreProcessor(GetAnalogCursor());
+	// Called from BeginDestroy, the module can already be unloaded on shutdown.
+	const FUIAdditionsPluginModule* UIAdditionsPluginModule = FModuleManager::GetModulePtr<FUIAdditionsPluginModule>(TEXT("UIAdditionsPlugin"));
+	const TSharedPtr<FMultiUserAnalogCursorPreProcessor> MultiUserProcessor = UIAdditionsPluginModule ? UIAdditionsPluginModule->GetMultiUserAnalogCursorPreProcessor() : nullptr;
+	if (MultiUserProcessor.IsValid()) {
+		MultiUserProcessor->RemoveCursor(GetAnalogCursor().ToSharedRef());
+	}
+	else {
+		FSlateApplication::Get().UnregisterInputPreProcessor(GetAnalogCursor());
+	}
 	AnalogCursor.Reset();
+	InteractableWidgetHitIndex.Reset();
 }
 
 bool AHUDCore::IsAnalogCursorValid() const {
@@ -552,6 +1119,9 @@ bool AHUDCore::GetFreezeCursorToCenterOfScreen() const {
 }
 
 void AHUDCore::SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenterOfScreen) {
+	if (bFreezeCursorToCenterOfScreen != bInFreezeCursorToCenterOfScreen) {
+		InvalidateMouseFreezeAnchor();
+	}
 	bFreezeCursorToCenterOfScreen = bInFreezeCursorToCenterOfScreen;
 	if (GetAnalogCursor().IsValid()) {
 		// This freezes the actual virtual cursor to a position.
@@ -564,9 +1134,41 @@ void AHUDCore::SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenterOfScr
 	}
 
 	// If freezing, the hardware cursor would have to be synchronized on tick, as it can not be locked.
+	if (GetFreezeCursorToCenterOfScreen()) {
+		RequestTick(TickRequestFrozenMouse);
+	}
+	else {
+		ReleaseTick(TickRequestFrozenMouse);
+	}
 	TickUpdateMouseLocation();
 }
 
+void AHUDCore::InvalidateMouseFreezeAnchor() {
+	bIsMouseFreezeAnchorValid = false;
+}
+
+void AHUDCore::UpdateInteractableWidgetHitIndexRoots() {
+	if (!InteractableWidgetHitIndex.IsValid()) {
+		return;
+	}
+	InteractableWidgetHitIndex->ClearRoots();
+	// Only the PawnHUD of the possessed pawn is relevant, others are collapsed.
+	for (const USubHUDWidget* SubHUDX : { GetPlayerViewportHUD(), GetPlayerScreenHUD(), FindPawnHUD(GetOwningPawn()) }) {
+		const TSharedPtr<SWidget> SubHUDWidget = IsValid(SubHUDX) ? SubHUDX->GetCachedWidget() : nullptr;
+		if (SubHUDWidget.IsValid()) {
+			InteractableWidgetHitIndex->AddRoot(SubHUDWidget.ToSharedRef());
+		}
+	}
+}
+
+bool AHUDCore::SnapCursorToNearestInteractableWidget(float InMaxDistance) {
+	if (!IsAnalogCursorValid()) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Can not snap the cursor, the analog cursor is not enabled."));
+		return false;
+	}
+	return GetAnalogCursor()->SnapToNearestInteractableWidget(InMaxDistance);
+}
+
 FVector2D AHUDCore::GetCursorPosition() const {
 	if (IsAnalogCursorValid()) {
 		return GetAnalogCursor()->GetCurrentPosition();
@@ -602,13 +1204,8 @@ void AHUDCore::MakeCustomCursorWidget(TSoftClassPtr<UCursorWidget> InCursorWidge
 	check(IsValid(GetCustomCursorWidget()));
 	GetCustomCursorWidget()->AddToViewport(ZIndexCursor);
 	GetCustomCursorWidget()->SetFreezeCursorToCenterOfScreen(GetFreezeCursorToCenterOfScreen());
-	// I intentionally did not move this context logic to the cursor itself (as observer). 
-	// It is only aware of its own context list and any implementation is up to the cursor.
-	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnDesiresCenteredWorldCursor"), GetPawnDesiresCenteredWorldCursor());
-	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerScreenHUDMenuVisible"), GetIsAnyPlayerScreenHUDMenuVisible());
-	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PlayerViewportHUDMenuVisible"), GetIsAnyPlayerViewportHUDMenuVisible());
-	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("PawnHUDMenuVisible"), GetIsAnyPawnHUDMenuVisible());
-	GetCustomCursorWidget()->AddOrRemoveCursorContext(TEXT("AnySubHUDMenuVisible"), IsAnySubHUDVisible());
+	// A new widget starts without contexts, so apply them right away.
+	UpdateCursorContexts();
 
 	/** 
 	* Set dummies to the software cursors in the viewport (same Software Cursors as in Project Settings > User Interface).
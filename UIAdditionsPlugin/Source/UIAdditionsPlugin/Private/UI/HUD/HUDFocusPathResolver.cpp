@@ -0,0 +1,66 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "HUDFocusPathResolver.h"
+#include "SubHUDWidget.h"
+#include "Layout/WidgetPath.h"
+#include "Widgets/SWidget.h"
+
+
+// Setup
+
+FHUDFocusPathResolver::FHUDFocusPathResolver(const USubHUDWidget* InViewportHUD, const USubHUDWidget* InScreenHUD, const USubHUDWidget* InPawnHUD) {
+	// A sub HUD without a constructed slate widget can't be on any focus path, so the cached widget is enough.
+	ViewportHUDWidget = IsValid(InViewportHUD) ? InViewportHUD->GetCachedWidget() : nullptr;
+	ScreenHUDWidget = IsValid(InScreenHUD) ? InScreenHUD->GetCachedWidget() : nullptr;
+	PawnHUDWidget = IsValid(InPawnHUD) ? InPawnHUD->GetCachedWidget() : nullptr;
+}
+
+// Resolve
+
+bool FHUDFocusPathResolver::TagWidget(const SWidget* InWidget, FHUDFocusPathLayers& OutLayers) const {
+	if (InWidget == nullptr) {
+		return false;
+	}
+	if (InWidget == ViewportHUDWidget.Get()) {
+		OutLayers.bContainsViewportHUD = true;
+	}
+	else if (InWidget == ScreenHUDWidget.Get()) {
+		OutLayers.bContainsScreenHUD = true;
+	}
+	else if (InWidget == PawnHUDWidget.Get()) {
+		OutLayers.bContainsPawnHUD = true;
+	}
+
+	return (OutLayers.bContainsViewportHUD || !ViewportHUDWidget.IsValid())
+		&& (OutLayers.bContainsScreenHUD || !ScreenHUDWidget.IsValid())
+		&& (OutLayers.bContainsPawnHUD || !PawnHUDWidget.IsValid());
+}
+
+FHUDFocusPathLayers FHUDFocusPathResolver::Resolve(const FWidgetPath& InPath) const {
+	FHUDFocusPathLayers Layers;
+	if (!InPath.IsValid()) {
+		return Layers;
+	}
+	Layers.bIsValid = true;
+
+	for (int32 i = 0; i < InPath.Widgets.Num(); i++) {
+		if (TagWidget(&InPath.Widgets[i].Widget.Get(), Layers)) {
+			break;
+		}
+	}
+	return Layers;
+}
+
+FHUDFocusPathLayers FHUDFocusPathResolver::Resolve(const FWeakWidgetPath& InPath) const {
+	FHUDFocusPathLayers Layers;
+	if (!InPath.IsValid()) {
+		return Layers;
+	}
+	Layers.bIsValid = true;
+
+	for (const TWeakPtr<SWidget>& WidgetX : InPath.Widgets) {
+		if (TagWidget(WidgetX.Pin().Get(), Layers)) {
+			break;
+		}
+	}
+	return Layers;
+}
@@ -39,6 +39,10 @@ void UDeferPaintWidget::SynchronizeProperties() {
 		MyDeferPaintWidget->SetHAlign(HorizontalAlignment);
 		MyDeferPaintWidget->SetVAlign(VerticalAlignment);
 		MyDeferPaintWidget->SetPadding(Padding);
+		MyDeferPaintWidget->SetBatchDeferredPainting(bBatchDeferredPainting);
+		MyDeferPaintWidget->SetDeferredLayer(DeferredLayer);
+		MyDeferPaintWidget->SetCullDeferredPainting(bCullDeferredPainting);
+		MyDeferPaintWidget->SetRetainDeferredContent(bRetainDeferredContent);
 	}
 }
 
@@ -158,5 +162,61 @@ void UDeferPaintWidget::SetPadding(FMargin InPadding) {
 	}
 }
 
+// Paint
+
+bool UDeferPaintWidget::GetBatchDeferredPainting() const {
+	return bBatchDeferredPainting;
+}
+
+void UDeferPaintWidget::SetBatchDeferredPainting(bool bInBatchDeferredPainting) {
+	bBatchDeferredPainting = bInBatchDeferredPainting;
+	if (MyDeferPaintWidget.IsValid()) {
+		MyDeferPaintWidget->SetBatchDeferredPainting(GetBatchDeferredPainting());
+	}
+}
+
+int32 UDeferPaintWidget::GetDeferredLayer() const {
+	return DeferredLayer;
+}
+
+void UDeferPaintWidget::SetDeferredLayer(int32 InDeferredLayer) {
+	DeferredLayer = InDeferredLayer;
+	if (MyDeferPaintWidget.IsValid()) {
+		MyDeferPaintWidget->SetDeferredLayer(GetDeferredLayer());
+	}
+}
+
+bool UDeferPaintWidget::GetCullDeferredPainting() const {
+	return bCullDeferredPainting;
+}
+
+void UDeferPaintWidget::SetCullDeferredPainting(bool bInCullDeferredPainting) {
+	bCullDeferredPainting = bInCullDeferredPainting;
+	if (MyDeferPaintWidget.IsValid()) {
+		MyDeferPaintWidget->SetCullDeferredPainting(GetCullDeferredPainting());
+	}
+}
+
+bool UDeferPaintWidget::GetRetainDeferredContent() const {
+	return bRetainDeferredContent;
+}
+
+void UDeferPaintWidget::SetRetainDeferredContent(bool bInRetainDeferredContent) {
+	bRetainDeferredContent = bInRetainDeferredContent;
+	if (MyDeferPaintWidget.IsValid()) {
+		MyDeferPaintWidget->SetRetainDeferredContent(GetRetainDeferredContent());
+	}
+}
+
+void UDeferPaintWidget::InvalidateRetainedContent() {
+	if (MyDeferPaintWidget.IsValid()) {
+		MyDeferPaintWidget->InvalidateRetainedContent();
+	}
+}
+
+int32 UDeferPaintWidget::GetNumDeferredGroupsPainted() const {
+	return MyDeferPaintWidget.IsValid() ? MyDeferPaintWidget->GetNumDeferredGroupsPainted() : 0;
+}
+
 
 #undef LOCTEXT_NAMESPACE
@@ -1,9 +1,165 @@
 /**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
 #include "SDeferPaintWidget.h"
+#include "CoreGlobals.h"
+#include "Widgets/SLeafWidget.h"
+#include "Rendering/DrawElements.h"
+#include "Layout/ArrangedWidget.h"
+#include "Widgets/SNullWidget.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Widgets/SWindow.h"
+#include "StatsUIAdditionsPlugin.h"
 
 
 static FName SDeferPaintWidgetTypeName("SDeferPaintWidget");
 
+// Batching
+
+class SDeferPaintBatchPainter;
+
+/* Deferred painting state of a window, shared by the deferred widgets painting into it. */
+struct FDeferPaintWindowState {
+
+	/* The window this state belongs to. Once it is destroyed, a new window can reuse its address. */
+	TWeakPtr<SWindow> Window = nullptr;
+
+	/* Created by the first batched widget painting into the window. */
+	TSharedPtr<SDeferPaintBatchPainter> BatchPainter = nullptr;
+
+	uint64 GroupsFrame = 0;
+
+	int32 NumGroupsThisFrame = 0;
+
+	int32 NumGroupsLastFrame = 0;
+
+	void CountGroups(int32 InNumGroups) {
+		if (GroupsFrame != GFrameCounter) {
+			NumGroupsLastFrame = NumGroupsThisFrame;
+			NumGroupsThisFrame = 0;
+			GroupsFrame = GFrameCounter;
+		}
+		NumGroupsThisFrame += InNumGroups;
+		INC_DWORD_STAT_BY(STAT_DeferPaint_Groups, InNumGroups);
+	}
+
+	int32 GetNumGroupsPainted() const {
+		return GroupsFrame != GFrameCounter ? NumGroupsThisFrame : NumGroupsLastFrame;
+	}
+
+};
+
+/**
+* The engine gives every deferred paint its own layers, on top of the previous deferred paint. That breaks batching between deferred widgets.
+* This painter is queued once per window and paints all batched deferred children queued to it, sorted by deferred layer.
+* Children sharing a deferred layer start painting on the same layer id, so elements using the same resources can batch.
+*/
+class SDeferPaintBatchPainter : public SLeafWidget {
+
+public:
+
+	struct FEntry {
+
+		int32 DeferredLayer = 0;
+
+		TSharedRef<FSlateWindowElementList::FDeferredPaint> DeferredPaint;
+
+	};
+
+	/* Entries queued during the current paint pass. */
+	mutable TArray<FEntry> Entries;
+
+	TWeakPtr<FDeferPaintWindowState> WindowState = nullptr;
+
+	/* Frame at which this painter was queued to its element list. */
+	uint64 QueuedFrame = 0;
+
+	/* Element list the painter was queued to. Only compared, to tell a new paint pass from the current one. */
+	const FSlateWindowElementList* QueuedElementList = nullptr;
+
+	mutable bool bIsQueued = false;
+
+public:
+
+	SLATE_BEGIN_ARGS(SDeferPaintBatchPainter) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs) {
+		SetCanTick(false);
+		SetVisibility(EVisibility::HitTestInvisible);
+	}
+
+	virtual FVector2D ComputeDesiredSize(float InLayoutScaleMultiplier) const override {
+		return FVector2D::ZeroVector;
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+};
+
+/* States by the window they belong to. Owned by the deferred widgets painting into that window. */
+static TMap<const SWindow*, TWeakPtr<FDeferPaintWindowState>> DeferPaintWindowStates;
+
+/* Returns the state of the window InElementList paints, or nullptr if it does not paint a window. */
+static TSharedPtr<FDeferPaintWindowState> FindOrAddDeferPaintWindowState(const FSlateWindowElementList& InElementList) {
+	SWindow* PaintWindow = InElementList.GetPaintWindow();
+	if (PaintWindow == nullptr) {
+		return nullptr;
+	}
+
+	TSharedPtr<FDeferPaintWindowState> WindowState = DeferPaintWindowStates.FindRef(PaintWindow).Pin();
+	if (WindowState.IsValid() && WindowState->Window.Pin().Get() == PaintWindow) {
+		return WindowState;
+	}
+
+	// Either new, or the state of a destroyed window at the same address.
+	for (auto It = DeferPaintWindowStates.CreateIterator(); It; ++It) {
+		const TSharedPtr<FDeferPaintWindowState> StateX = It.Value().Pin();
+		if (!StateX.IsValid() || !StateX->Window.IsValid()) {
+			It.RemoveCurrent();
+		}
+	}
+	WindowState = MakeShared<FDeferPaintWindowState>();
+	WindowState->Window = StaticCastSharedRef<SWindow>(PaintWindow->AsShared());
+	DeferPaintWindowStates.Add(PaintWindow, WindowState);
+	return WindowState;
+}
+
+int32 SDeferPaintBatchPainter::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const {
+	int32 MaxLayerId = LayerId;
+	int32 GroupLayerId = LayerId;
+	int32 NumGroups = 0;
+
+	// Children queued while painting (nested deferred widgets) are painted in a next round, sorted among themselves, above everything painted before.
+	TArray<FEntry> RoundEntries;
+	while (Entries.Num() > 0) {
+		Swap(RoundEntries, Entries);
+		Entries.Reset();
+
+		// Stable, children of the same layer keep the order in which they were queued.
+		RoundEntries.StableSort([](const FEntry& InA, const FEntry& InB) {
+			return InA.DeferredLayer < InB.DeferredLayer;
+		});
+
+		for (int32 i = 0; i < RoundEntries.Num(); i++) {
+			if (i == 0 || RoundEntries[i].DeferredLayer != RoundEntries[i - 1].DeferredLayer) {
+				// A new group starts on top of everything the previous group painted.
+				GroupLayerId = (NumGroups == 0) ? LayerId : MaxLayerId + 1;
+				NumGroups++;
+			}
+			// Every child paints with the geometry, style and culling it was queued with.
+			MaxLayerId = FMath::Max(MaxLayerId, RoundEntries[i].DeferredPaint->ExecutePaint(GroupLayerId, OutDrawElements, MyCullingRect));
+		}
+		RoundEntries.Reset();
+	}
+
+	bIsQueued = false;
+	const TSharedPtr<FDeferPaintWindowState> PinnedWindowState = WindowState.Pin();
+	if (PinnedWindowState.IsValid()) {
+		PinnedWindowState->CountGroups(NumGroups);
+	}
+
+	return MaxLayerId;
+}
+
 // Setup
 
 SDeferPaintWidget::SDeferPaintWidget() {
@@ -21,25 +177,43 @@ void SDeferPaintWidget::Construct(const SDeferPaintWidget::FArguments& InArgs) {
 		bCanSupportFocus = false;
 	}
 
+	bBatchDeferredPainting = InArgs._BatchDeferredPainting;
+	DeferredLayer = InArgs._DeferredLayer;
+	bCullDeferredPainting = InArgs._CullDeferredPainting;
+
 	ChildSlot
 		.HAlign(InArgs._HAlign)
 		.VAlign(InArgs._VAlign)
-		.Padding(InArgs._Padding)
-		[InArgs._Content.Widget];
+		.Padding(InArgs._Padding);
+
+	SetContent(InArgs._Content.Widget);
+	SetRetainDeferredContent(InArgs._RetainDeferredContent);
 }
 
 // Content
 
 void SDeferPaintWidget::SetContent(TSharedRef<SWidget> InContent) {
-	ChildSlot[InContent];
+	DeferredContent = InContent;
+	if (RetainerPanel.IsValid()) {
+		RetainerPanel->SetContent(InContent);
+	}
+	else {
+		ChildSlot[InContent];
+	}
 }
 
 const TSharedRef<SWidget>& SDeferPaintWidget::GetContent() const {
-	return ChildSlot.GetWidget();
+	return DeferredContent;
 }
 
 void SDeferPaintWidget::ClearContent() {
-	ChildSlot.DetachWidget();
+	DeferredContent = SNullWidget::NullWidget;
+	if (RetainerPanel.IsValid()) {
+		RetainerPanel->SetContent(SNullWidget::NullWidget);
+	}
+	else {
+		ChildSlot.DetachWidget();
+	}
 }
 
 // Appearance
@@ -56,8 +230,143 @@ void SDeferPaintWidget::SetPadding(const TAttribute<FMargin>& InPadding) {
 	ChildSlot.SetPadding(InPadding);
 }
 
+// Batching
+
+bool SDeferPaintWidget::GetBatchDeferredPainting() const {
+	return bBatchDeferredPainting;
+}
+
+void SDeferPaintWidget::SetBatchDeferredPainting(bool bInBatchDeferredPainting) {
+	if (bBatchDeferredPainting == bInBatchDeferredPainting) {
+		return;
+	}
+	bBatchDeferredPainting = bInBatchDeferredPainting;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SDeferPaintWidget::GetDeferredLayer() const {
+	return DeferredLayer;
+}
+
+void SDeferPaintWidget::SetDeferredLayer(int32 InDeferredLayer) {
+	if (DeferredLayer == InDeferredLayer) {
+		return;
+	}
+	DeferredLayer = InDeferredLayer;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SDeferPaintWidget::GetNumDeferredGroupsPainted() const {
+	return WindowState.IsValid() ? WindowState->GetNumGroupsPainted() : 0;
+}
+
+// Culling
+
+bool SDeferPaintWidget::GetCullDeferredPainting() const {
+	return bCullDeferredPainting;
+}
+
+void SDeferPaintWidget::SetCullDeferredPainting(bool bInCullDeferredPainting) {
+	if (bCullDeferredPainting == bInCullDeferredPainting) {
+		return;
+	}
+	bCullDeferredPainting = bInCullDeferredPainting;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+bool SDeferPaintWidget::IsDeferredPaintCulled(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, const FWidgetStyle& InWidgetStyle) const {
+	const TSharedRef<SWidget>& Content = GetContent();
+
+	if (Content == SNullWidget::NullWidget || !Content->GetVisibility().IsVisible()) {
+		return true;
+	}
+	if (InWidgetStyle.GetColorAndOpacityTint().A <= 0.f || Content->GetRenderOpacity() <= 0.f) {
+		return true;
+	}
+	if (GetCullDeferredPainting()) {
+		// The child is deferred with the geometry of this widget. Same test as the regular paint of a child, including its culling bounds extension.
+		return IsChildWidgetCulled(MyCullingRect, FArrangedWidget(Content, AllottedGeometry));
+	}
+	return false;
+}
+
+// Retained
+
+bool SDeferPaintWidget::GetRetainDeferredContent() const {
+	return RetainerPanel.IsValid();
+}
+
+void SDeferPaintWidget::SetRetainDeferredContent(bool bInRetainDeferredContent) {
+	if (GetRetainDeferredContent() == bInRetainDeferredContent) {
+		return;
+	}
+
+	if (bInRetainDeferredContent) {
+		RetainerPanel = SNew(SInvalidationPanel)
+			[DeferredContent];
+		ChildSlot[RetainerPanel.ToSharedRef()];
+	}
+	else {
+		RetainerPanel->SetContent(SNullWidget::NullWidget);
+		RetainerPanel.Reset();
+		ChildSlot[DeferredContent];
+	}
+}
+
+void SDeferPaintWidget::InvalidateRetainedContent() {
+	if (RetainerPanel.IsValid()) {
+		RetainerPanel->InvalidateRootLayout(this);
+	}
+}
+
+// Paint
+
 int32 SDeferPaintWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const {
-	// This causes the widget to render after everything else
-	OutDrawElements.QueueDeferredPainting(FSlateWindowElementList::FDeferredPaint(ChildSlot.GetWidget(), Args, AllottedGeometry, InWidgetStyle, bParentEnabled));
-	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, ShouldBeEnabled(bParentEnabled));
+	if (IsDeferredPaintCulled(AllottedGeometry, MyCullingRect, InWidgetStyle)) {
+		INC_DWORD_STAT(STAT_DeferPaint_Culled);
+		return LayerId;
+	}
+	INC_DWORD_STAT(STAT_DeferPaint_Painted);
+
+	// Find the state of the window this paints into. The widget can move to another window, or its window can be replaced.
+	if (!WindowState.IsValid() || WindowState->Window.Pin().Get() != OutDrawElements.GetPaintWindow()) {
+		WindowState = FindOrAddDeferPaintWindowState(OutDrawElements);
+	}
+
+	if (!GetBatchDeferredPainting() || !WindowState.IsValid()) {
+		// This causes the widget to render after everything else
+		OutDrawElements.QueueDeferredPainting(FSlateWindowElementList::FDeferredPaint(ChildSlot.GetWidget(), Args, AllottedGeometry, InWidgetStyle, bParentEnabled));
+		if (WindowState.IsValid()) {
+			WindowState->CountGroups(1);
+		}
+	}
+	else {
+		if (!WindowState->BatchPainter.IsValid()) {
+			WindowState->BatchPainter = SNew(SDeferPaintBatchPainter);
+			WindowState->BatchPainter->WindowState = WindowState;
+		}
+		SDeferPaintBatchPainter& BatchPainter = *WindowState->BatchPainter;
+
+		if (BatchPainter.bIsQueued && (BatchPainter.QueuedFrame != GFrameCounter || BatchPainter.QueuedElementList != &OutDrawElements)) {
+			// The element list was not painted since the painter was queued, drop what it had left.
+			BatchPainter.Entries.Reset();
+			BatchPainter.bIsQueued = false;
+		}
+		if (!BatchPainter.bIsQueued) {
+			// The painter renders after everything else, together with all children batched to it this pass. It is not tied to the geometry or style of any of them.
+			OutDrawElements.QueueDeferredPainting(FSlateWindowElementList::FDeferredPaint(WindowState->BatchPainter.ToSharedRef(), Args, FGeometry(), FWidgetStyle(), true));
+			BatchPainter.bIsQueued = true;
+			BatchPainter.QueuedFrame = GFrameCounter;
+			BatchPainter.QueuedElementList = &OutDrawElements;
+		}
+
+		BatchPainter.Entries.Add({ GetDeferredLayer(), MakeShared<FSlateWindowElementList::FDeferredPaint>(ChildSlot.GetWidget(), Args, AllottedGeometry, InWidgetStyle, bParentEnabled) });
+	}
+
+	/**
+	* The child is not painted inline. The deferred pass paints it on top of everything else, including its hit test, so painting it here as well only doubles its cost.
+	* A retained child would even have its cache invalidated every paint, as it would be painted on different layers.
+	* A culled child would not draw anything inline either.
+	*/
+	return LayerId;
 }
@@ -11,6 +11,12 @@
 #include "SlateUtils.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "LogUIAdditionsPlugin.h"
+#include "MenuWidget.h"
+#include "Engine/World.h"
+#include "LazyWidgetSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "LazyWidgetTelemetry.h"
+#include "StatsUIAdditionsPlugin.h"
 
 #define LOCTEXT_NAMESPACE "UIAdditionsPlugin"
 
@@ -34,6 +40,7 @@ void ULazyWidget::SynchronizeProperties() {
 void ULazyWidget::ReleaseSlateResources(bool bInReleaseChildren) {
 	Super::ReleaseSlateResources(bInReleaseChildren);
 
+	StopTrackingAncestorVisibility();
 	MyLazyWidget.Reset();
 }
 
@@ -124,6 +131,11 @@ void ULazyWidget::OnWidgetRebuilt() {
 		OuterUserWidget->OnVisibilityChanged.AddDynamic(this, &ULazyWidget::ActOnOuterVisibilityChanged);
 	}
 
+	StopTrackingAncestorVisibility();
+	if (GetLoadControlledByAncestorVisibility()) {
+		StartTrackingAncestorVisibility();
+	}
+
 	ConditionalLoadOrUnloadContent();
 }
 
@@ -183,6 +195,9 @@ const FText ULazyWidget::GetPaletteCategory() {
 // Appearance
 
 void ULazyWidget::SetVisibility(ESlateVisibility InVisibility) {
+	if (!USlateUtils::IsVisible(InVisibility)) {
+		MarkContentHidden();
+	}
 	Super::SetVisibility(InVisibility);
 	ConditionalLoadOrUnloadContent();
 }
@@ -256,6 +271,38 @@ void ULazyWidget::SetLoadControlledBySelfVisibility(bool bInLoadControlledBySelf
 	ConditionalLoadOrUnloadContent();
 }
 
+bool ULazyWidget::GetLoadControlledByAncestorVisibility() const {
+	return bLoadControlledByAncestorVisibility;
+}
+
+void ULazyWidget::SetLoadControlledByAncestorVisibility(bool bInLoadControlledByAncestorVisibility) {
+	if (GetLoadControlledByAncestorVisibility() == bInLoadControlledByAncestorVisibility) {
+		return;
+	}
+
+	bLoadControlledByAncestorVisibility = bInLoadControlledByAncestorVisibility;
+
+	StopTrackingAncestorVisibility();
+	if (GetLoadControlledByAncestorVisibility() && MyLazyWidget.IsValid() && !IsDesignTime()) {
+		StartTrackingAncestorVisibility();
+	}
+
+	ConditionalLoadOrUnloadContent();
+}
+
+bool ULazyWidget::GetLoadControlledByScrollVisibility() const {
+	return bLoadControlledByScrollVisibility;
+}
+
+void ULazyWidget::SetLoadControlledByScrollVisibility(bool bInLoadControlledByScrollVisibility) {
+	if (GetLoadControlledByScrollVisibility() == bInLoadControlledByScrollVisibility) {
+		return;
+	}
+
+	bLoadControlledByScrollVisibility = bInLoadControlledByScrollVisibility;
+	ConditionalLoadOrUnloadContent();
+}
+
 bool ULazyWidget::GetCollectGarbageOnUnload() const {
 	return bCollectGarbageOnUnload;
 }
@@ -264,6 +311,36 @@ void ULazyWidget::SetCollectGarbageOnUnload(bool bInCollectGarbageOnUnload) {
 	bCollectGarbageOnUnload = bInCollectGarbageOnUnload;
 }
 
+int32 ULazyWidget::GetEvictionPriority() const {
+	return EvictionPriority;
+}
+
+void ULazyWidget::SetEvictionPriority(int32 InEvictionPriority) {
+	EvictionPriority = InEvictionPriority;
+}
+
+bool ULazyWidget::IsLoadControlledByVisibility() const {
+	return GetLoadControlledBySelfVisibility()
+		|| GetLoadControlledByOuterVisibility()
+		|| GetLoadControlledByAncestorVisibility();
+}
+
+bool ULazyWidget::IsHiddenByLoadCondition() const {
+	if (GetLoadControlledBySelfVisibility() && !USlateUtils::IsVisible(GetVisibility())) {
+		return true;
+	}
+	if (GetLoadControlledByOuterVisibility() && (!IsValid(OuterUserWidget) || !USlateUtils::IsVisible(OuterUserWidget->GetVisibility()))) {
+		return true;
+	}
+	if (GetLoadControlledByAncestorVisibility() && !USlateUtils::IsVisibleInHierarchy(this, GetLoadControlledByScrollVisibility())) {
+		// Without polling only the ancestor menus report becoming visible again.
+		return AncestorVisibilityPollInterval > 0.f || AncestorMenus.ContainsByPredicate([](const UMenuWidget* InMenuX) {
+			return IsValid(InMenuX) && !USlateUtils::IsVisible(InMenuX->GetVisibility());
+		});
+	}
+	return false;
+}
+
 TSoftClassPtr<UUserWidget> ULazyWidget::GetLazyContent() const {
 	return LazyContent;
 }
@@ -280,6 +357,12 @@ void ULazyWidget::UnloadContent() {
 		// Any delegates to the handle should be unbound automatically. Nothing left to do here.
 		StreamingHandle.Reset();
 	}
+
+	ULazyWidgetSubsystem* LazyWidgetSubsystem = GetLazyWidgetSubsystem();
+	if (IsValid(LazyWidgetSubsystem)) {
+		LazyWidgetSubsystem->UnRegisterLoadedContent(this);
+	}
+
 	// This will clear the slot, then call OnSlotRemoved to sync the slate widget.
 	ClearChildren();
 
@@ -294,6 +377,11 @@ void ULazyWidget::UnloadContent() {
 
 #endif // WITH_EDITOR
 
+		if (IsValid(LazyWidgetSubsystem) && LazyWidgetSubsystem->IsEnforcingMemoryBudget()) {
+			// The subsystem collects garbage once after evicting, instead of once per evicted widget.
+			return;
+		}
+
 		/* 
 		* Invisible and even removed widgets can still cause a terrible performance in the Slate system until they are garbage collected.
 		* Tip: The hit of collecting garbage might be unnoticable if you had pause on.
@@ -303,12 +391,14 @@ void ULazyWidget::UnloadContent() {
 }
 
 void ULazyWidget::ConditionalLoadOrUnloadContent() {
+	LoadOrUnloadContent(TOptional<bool>());
+}
+
+void ULazyWidget::LoadOrUnloadContent(TOptional<bool> InIsVisibleInHierarchy) {
 	if (GetLazyContent().IsNull()) {
 		return;
 	}
-	if (!GetLoadControlledBySelfVisibility()
-		&& !GetLoadControlledByOuterVisibility()
-		) {
+	if (!IsLoadControlledByVisibility()) {
 		// By default do nothing if there is no condition to control the loading.
 		return;
 	}
@@ -327,20 +417,62 @@ void ULazyWidget::ConditionalLoadOrUnloadContent() {
 		}
 	} 
 
+	if (GetLoadControlledByAncestorVisibility()) {
+		bIsVisibleInHierarchy = InIsVisibleInHierarchy.IsSet() ? InIsVisibleInHierarchy.GetValue() : USlateUtils::IsVisibleInHierarchy(this, GetLoadControlledByScrollVisibility());
+		if (!bIsVisibleInHierarchy) {
+			UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: Unload, an ancestor is not visible."), *GetName());
+			UnloadContent();
+			return;
+		}
+	}
+
 	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: LoadContent."), *GetName());
+
+	ULazyWidgetSubsystem* LazyWidgetSubsystem = GetLazyWidgetSubsystem();
+	if (IsValid(LazyWidgetSubsystem)) {
+		LazyWidgetSubsystem->MarkContentVisible(this);
+	}
+
 	LoadContent();
 }
 
-void ULazyWidget::SetLoadedContent(const TSubclassOf<UUserWidget> InContentClass) {
-	// This will set the slot, then call OnSlotAdded to sync with the slate widget.
-	UUserWidget* NewContent = CreateWidget(this, InContentClass);
+void ULazyWidget::SetLoadedContent(const TSubclassOf<UUserWidget> InContentClass, int32 InSyncLoadCounterAtStart) {
+	FLazyWidgetTelemetry& Telemetry = FLazyWidgetTelemetry::Get();
+	const double CreateWidgetStartTime = FPlatformTime::Seconds();
+	UUserWidget* NewContent = nullptr;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_LazyWidget_CreateWidget);
+		NewContent = CreateWidget(this, InContentClass);
+	}
+	const double CreateWidgetSeconds = FPlatformTime::Seconds() - CreateWidgetStartTime;
+
 	if (IsValid(NewContent)) {
+		// This will set the slot, then call OnSlotAdded to sync with the slate widget, which constructs the content if this widget is constructed.
 		SetContent(NewContent);
+
+		if (!IsDesignTime()) {
+			Telemetry.MarkConstructed(TelemetryRecordIndex, CreateWidgetSeconds, Telemetry.GetSyncLoadCounter() - InSyncLoadCounterAtStart);
+		}
+
+		ULazyWidgetSubsystem* LazyWidgetSubsystem = GetLazyWidgetSubsystem();
+		if (IsValid(LazyWidgetSubsystem)) {
+			// Content is accounted for and may cause the eviction of other hidden content.
+			LazyWidgetSubsystem->RegisterLoadedContent(this);
+		}
+
 		// Note that SetContent does not immediately result in Initialize / (Pre) Construct being called on a widget.
 		OnLoadComplete.Broadcast();
 	}
 }
 
+ULazyWidgetSubsystem* ULazyWidget::GetLazyWidgetSubsystem() const {
+	if (IsDesignTime()) {
+		return nullptr;
+	}
+	const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+	return IsValid(LocalPlayer) ? LocalPlayer->GetSubsystem<ULazyWidgetSubsystem>() : nullptr;
+}
+
 void ULazyWidget::LoadContent() {
 	if (GetLazyContent().IsNull()) {
 		return;
@@ -363,15 +495,28 @@ void ULazyWidget::LoadContent() {
 
 	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Loading content"));
 
+	FLazyWidgetTelemetry& Telemetry = FLazyWidgetTelemetry::Get();
+	const bool bRecordTelemetry = !IsDesignTime();
+	const bool bIsAlreadyLoaded = GetLazyContent().Get() != nullptr;
+	TelemetryRecordIndex = bRecordTelemetry ? Telemetry.BeginLoad(this, GetLoadAsync() && !bIsAlreadyLoaded) : INDEX_NONE;
+
 	if (!GetLoadAsync()) {
-		SetLoadedContent(GetLazyContent().LoadSynchronous());
+		const int32 SyncLoadCounterAtStart = Telemetry.GetSyncLoadCounter();
+		const TSubclassOf<UUserWidget> LoadedClass = GetLazyContent().LoadSynchronous();
+		if (bRecordTelemetry) {
+			Telemetry.MarkLoaded(TelemetryRecordIndex);
+		}
+		SetLoadedContent(LoadedClass, SyncLoadCounterAtStart);
 		// Finished.
 		return;
 	}
 
-	if (GetLazyContent().Get()) {
+	if (bIsAlreadyLoaded) {
 		// Already loaded, but not set.
-		SetLoadedContent(GetLazyContent().Get());
+		if (bRecordTelemetry) {
+			Telemetry.MarkLoaded(TelemetryRecordIndex);
+		}
+		SetLoadedContent(GetLazyContent().Get(), Telemetry.GetSyncLoadCounter());
 		// Finished.
 		return;
 	}
@@ -385,7 +530,9 @@ void ULazyWidget::LoadContent() {
 		ULazyWidget* StrongThis = WeakThis.Get();
 		if (IsValid(StrongThis)) {
 			UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: lazy CompleteDelegate"), *StrongThis->GetName());
-			StrongThis->SetLoadedContent(StrongThis->GetLazyContent().Get());
+			FLazyWidgetTelemetry& Telemetry = FLazyWidgetTelemetry::Get();
+			Telemetry.MarkLoaded(StrongThis->TelemetryRecordIndex);
+			StrongThis->SetLoadedContent(StrongThis->GetLazyContent().Get(), Telemetry.GetSyncLoadCounter());
 		}
 	}, FStreamableManager::AsyncLoadHighPriority);
 
@@ -404,6 +551,7 @@ void ULazyWidget::LoadContent() {
 			ULazyWidget* StrongThis = WeakThis.Get();
 			if (IsValid(StrongThis)) {
 				UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: lazy CancelDelegate"), *StrongThis->GetName());
+				FLazyWidgetTelemetry::Get().MarkCancelled(StrongThis->TelemetryRecordIndex);
 				StrongThis->OnLazyLoadCancelled.Broadcast();
 			}
 		});
@@ -423,11 +571,76 @@ void ULazyWidget::LoadContent() {
 	}
 }
 
+void ULazyWidget::StartTrackingAncestorVisibility() {
+	/**
+	* The engine does not broadcast a change in visibility relative to ancestors.
+	* Menus do broadcast when they are shown or hidden (which is how routes are displayed), so they are bound to directly.
+	* Anything else (panels, switchers, scroll regions) is tested on a slow poll, which only acts when the result changes.
+	*/
+	UMenuWidget* MenuX = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(this);
+	while (IsValid(MenuX)) {
+		MenuX->OnMenuVisibilityChanged.AddUniqueDynamic(this, &ULazyWidget::ActOnAncestorMenuVisibilityChanged);
+		AncestorMenus.Add(MenuX);
+		MenuX = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(MenuX);
+	}
+
+	bIsVisibleInHierarchy = USlateUtils::IsVisibleInHierarchy(this, GetLoadControlledByScrollVisibility());
+
+	if (AncestorVisibilityPollInterval > 0.f) {
+		AncestorVisibilityPollHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ULazyWidget::ActOnAncestorVisibilityPoll), AncestorVisibilityPollInterval);
+	}
+}
+
+void ULazyWidget::StopTrackingAncestorVisibility() {
+	for (UMenuWidget* MenuX : AncestorMenus) {
+		if (IsValid(MenuX)) {
+			MenuX->OnMenuVisibilityChanged.RemoveDynamic(this, &ULazyWidget::ActOnAncestorMenuVisibilityChanged);
+		}
+	}
+	AncestorMenus.Empty();
+
+	if (AncestorVisibilityPollHandle.IsValid()) {
+		FTSTicker::GetCoreTicker().RemoveTicker(AncestorVisibilityPollHandle);
+		AncestorVisibilityPollHandle.Reset();
+	}
+}
+
+void ULazyWidget::MarkContentHidden() {
+	ULazyWidgetSubsystem* LazyWidgetSubsystem = GetLazyWidgetSubsystem();
+	if (IsValid(LazyWidgetSubsystem)) {
+		LazyWidgetSubsystem->MarkContentHidden(this);
+	}
+}
+
 // Delegates
 
 void ULazyWidget::ActOnOuterVisibilityChanged(ESlateVisibility InVisibility) {
+	if (!USlateUtils::IsVisible(InVisibility)) {
+		MarkContentHidden();
+	}
 	ConditionalLoadOrUnloadContent();
 }
 
+void ULazyWidget::ActOnAncestorMenuVisibilityChanged(UMenuWidget* InMenuWidget, bool bInIsVisible) {
+	if (!bInIsVisible) {
+		MarkContentHidden();
+	}
+	ConditionalLoadOrUnloadContent();
+}
+
+bool ULazyWidget::ActOnAncestorVisibilityPoll(float InDeltaTime) {
+	const bool bNewIsVisibleInHierarchy = USlateUtils::IsVisibleInHierarchy(this, GetLoadControlledByScrollVisibility());
+	if (bNewIsVisibleInHierarchy != bIsVisibleInHierarchy) {
+		bIsVisibleInHierarchy = bNewIsVisibleInHierarchy;
+		if (!bIsVisibleInHierarchy) {
+			MarkContentHidden();
+		}
+		// Walking the hierarchy is the cost of the poll, reuse the result.
+		LoadOrUnloadContent(bNewIsVisibleInHierarchy);
+	}
+	// Keep polling until StopTrackingAncestorVisibility.
+	return true;
+}
+
 
 #undef LOCTEXT_NAMESPACE
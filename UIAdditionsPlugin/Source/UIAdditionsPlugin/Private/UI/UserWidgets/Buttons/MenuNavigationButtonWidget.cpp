@@ -12,7 +12,8 @@
 void UMenuNavigationButtonWidget::NativeConstruct() {
 	Super::NativeConstruct();
 
-	if (GetAutoRegisterToParentMenu()) {
+	// Normally registered during NativeOnInitialized already, through the menu building this button.
+	if (GetAutoRegisterToParentMenu() && !IsValid(GetRegisteredParentMenu())) {
 		RegisterToParentMenu();
 	}
 }
@@ -20,7 +21,7 @@ void UMenuNavigationButtonWidget::NativeConstruct() {
 void UMenuNavigationButtonWidget::NativeOnInitialized() {
 	Super::NativeOnInitialized();
 
-	if (GetAutoRegisterToParentMenu()) {
+	if (GetAutoRegisterToParentMenu() && !IsValid(GetRegisteredParentMenu())) {
 		RegisterToParentMenu();
 	}
 }
@@ -38,12 +39,18 @@ void UMenuNavigationButtonWidget::SetAutoRegisterToParentMenu(bool bInAutoRegist
 void UMenuNavigationButtonWidget::RegisterToParentMenu() {
 	// When a widget is added to the viewport, or to a parent widget, we want to update our registration to a parent menu.
 	// Multiple registrations are allowed and not managed or validated on the button level.
-	UMenuWidget* NewParentMenuWidget = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(this);
+	bool bIsInitializingParentMenu = false;
+	UMenuWidget* NewParentMenuWidget = UMenuWidget::FindParentMenu(this, bIsInitializingParentMenu);
 	if (IsValid(NewParentMenuWidget)) {
 		NewParentMenuWidget->RegisterNavigationButton(this);
+		RegisteredParentMenu = NewParentMenuWidget;
 	}
 }
 
+UMenuWidget* UMenuNavigationButtonWidget::GetRegisteredParentMenu() const {
+	return RegisteredParentMenu;
+}
+
 FName UMenuNavigationButtonWidget::GetNavigationRoute() const {
 	return NavigationRoute;
 }
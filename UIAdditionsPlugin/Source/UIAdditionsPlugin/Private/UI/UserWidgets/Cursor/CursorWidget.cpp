@@ -13,6 +13,8 @@
 #include "SlateUtils.h"
 #include "ExtendedAnalogCursor.h"
 #include "InputState.h"
+#include "Engine/GameViewportClient.h"
+#include "Misc/CoreDelegates.h"
 
 
 // Setup
@@ -33,6 +35,25 @@ void UCursorWidget::NativeOnInitialized() {
 	OnCursorContextsChanged();
 }
 
+void UCursorWidget::NativeConstruct() {
+	Super::NativeConstruct();
+
+	ViewportGeometryCache.OnInvalidated.AddUObject(this, &UCursorWidget::ActOnViewportGeometryInvalidated);
+	InvalidateCachedLookups();
+}
+
+void UCursorWidget::NativeDestruct() {
+	if (CursorContextBatchDepth > 0) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Cursor widget destructed with an open cursor context batch, committing it."));
+		CloseCursorContextBatch();
+	}
+	ViewportGeometryCache.OnInvalidated.RemoveAll(this);
+	ViewportGeometryCache.Reset();
+	InvalidateCachedLookups();
+
+	Super::NativeDestruct();
+}
+
 // Tick
 
 void UCursorWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime) {
@@ -42,19 +63,18 @@ void UCursorWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime) {
 }
 
 void UCursorWidget::TickUpdateCursorPosition() {
-	TSharedPtr<FSlateUser> SlateUser = USlateUtils::GetSlateUserForPlayerController(GetOwningPlayer());
+	const TSharedPtr<FSlateUser> SlateUser = GetSlateUser();
 	if (SlateUser == nullptr) {
 		return;
 	}
-	UCanvasPanelSlot* CanvasSlot = IsValid(CursorContainer) ? Cast<UCanvasPanelSlot>(CursorContainer->Slot) : nullptr;
-	if (!IsValid(CanvasSlot)) {
+	if (!IsValid(CursorContainer)) {
 		return;
 	}
 
 	// Get absolute coordinates into NewPosition.
 	FVector2D UnProcessedPosition = FVector2D::ZeroVector;
 	if (GetFreezeCursorToCenterOfScreen()) {
-		UnProcessedPosition = USlateUtils::GetCenterOfPlayerScreen(GetOwningLocalPlayer());
+		UnProcessedPosition = USlateUtils::GetCenterOfPlayerScreen(GetGameViewportClient(), GetOwningLocalPlayer());
 	}
 	else {
 		UnProcessedPosition = SlateUser->GetCursorPosition();
@@ -77,17 +97,66 @@ void UCursorWidget::TickUpdateCursorPosition() {
 	//	: UWidgetLayoutLibrary::GetViewportWidgetGeometry(GetOwningPlayer())
 	//);
 
-	FGeometry ViewportGeometry = UWidgetLayoutLibrary::GetViewportWidgetGeometry(GetOwningPlayer());
+	const FGeometry& ViewportGeometry = GetViewportGeometry();
 	FVector2D LocalPosition = USlateUtils::ClampLocalPositionToGeometry(ViewportGeometry, ViewportGeometry.AbsoluteToLocal(UnProcessedPosition));
 
 	// Store the absolute position to be available on request.
 	Position = ViewportGeometry.LocalToAbsolute(LocalPosition);
 
-	// Use the local position for the canvas slot.
-	CanvasSlot->SetPosition(LocalPosition);
+	ApplyLocalPosition(LocalPosition);
 	//UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Position: %s"), *LocalPosition.ToString());
 }
 
+TSharedPtr<FSlateUser> UCursorWidget::GetSlateUser() {
+	APlayerController* OwningPlayer = GetOwningPlayer();
+	if (CachedOwningPlayer != OwningPlayer) {
+		InvalidateCachedLookups();
+		CachedOwningPlayer = OwningPlayer;
+	}
+
+	TSharedPtr<FSlateUser> SlateUser = CachedSlateUser.Pin();
+	if (!SlateUser.IsValid()) {
+		SlateUser = USlateUtils::GetSlateUserForPlayerController(OwningPlayer);
+		CachedSlateUser = SlateUser;
+	}
+	return SlateUser;
+}
+
+UGameViewportClient* UCursorWidget::GetGameViewportClient() {
+	return ViewportGeometryCache.GetGameViewportClient(this);
+}
+
+const FGeometry& UCursorWidget::GetViewportGeometry() {
+	// Binds the cache to the viewport events on first use.
+	GetGameViewportClient();
+	return ViewportGeometryCache.GetGeometry([this]() {
+		return UWidgetLayoutLibrary::GetViewportWidgetGeometry(GetOwningPlayer());
+	});
+}
+
+void UCursorWidget::ApplyLocalPosition(const FVector2D& InLocalPosition) {
+	if (bHasAppliedLocalPosition && LastAppliedLocalPosition.Equals(InLocalPosition)) {
+		// Nothing moved, don't invalidate anything.
+		return;
+	}
+
+	if (CursorPositioningMode == E_CursorPositioningModes::RenderTransform) {
+		// A render translation only invalidates paint, layout of the canvas stays cached.
+		CursorContainer->SetRenderTranslation(InLocalPosition);
+	}
+	else {
+		UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(CursorContainer->Slot);
+		if (!IsValid(CanvasSlot)) {
+			return;
+		}
+		// Use the local position for the canvas slot.
+		CanvasSlot->SetPosition(InLocalPosition);
+	}
+
+	LastAppliedLocalPosition = InLocalPosition;
+	bHasAppliedLocalPosition = true;
+}
+
 // Appearance
 
 void UCursorWidget::Show() {
@@ -102,6 +171,31 @@ FVector2D UCursorWidget::GetPosition() const {
 	return Position;
 }
 
+E_CursorPositioningModes UCursorWidget::GetCursorPositioningMode() const {
+	return CursorPositioningMode;
+}
+
+void UCursorWidget::SetCursorPositioningMode(E_CursorPositioningModes InCursorPositioningMode) {
+	if (CursorPositioningMode == InCursorPositioningMode) {
+		return;
+	}
+	if (IsValid(CursorContainer)) {
+		// Reset the offset applied by the previous mode so the two don't stack.
+		if (CursorPositioningMode == E_CursorPositioningModes::RenderTransform) {
+			CursorContainer->SetRenderTranslation(FVector2D::ZeroVector);
+		}
+		else {
+			UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(CursorContainer->Slot);
+			if (IsValid(CanvasSlot)) {
+				CanvasSlot->SetPosition(FVector2D::ZeroVector);
+			}
+		}
+	}
+	CursorPositioningMode = InCursorPositioningMode;
+	// Force the next tick to apply the position in the new mode.
+	bHasAppliedLocalPosition = false;
+}
+
 bool UCursorWidget::GetFreezeCursorToCenterOfScreen() const {
 	return bFreezeCursorToCenterOfScreen;
 }
@@ -110,18 +204,118 @@ void UCursorWidget::SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenter
 	bFreezeCursorToCenterOfScreen = bInFreezeCursorToCenterOfScreen;
 }
 
-const TSet<FName>& UCursorWidget::GetCursorContexts() const {
-	return CursorContexts;
+void UCursorWidget::InvalidateCachedLookups() {
+	CachedSlateUser.Reset();
+	ViewportGeometryCache.Invalidate();
 }
 
-void UCursorWidget::AddCursorContext(const FName& InContext) {
-	CursorContexts.Add(InContext);
+TMap<FName, int32>& UCursorWidget::GetCursorContextIndices() {
+	static TMap<FName, int32> CursorContextIndices;
+	return CursorContextIndices;
+}
+
+TArray<FName>& UCursorWidget::GetCursorContextNames() {
+	static TArray<FName> CursorContextNames;
+	return CursorContextNames;
+}
+
+int32 UCursorWidget::FindOrRegisterCursorContextIndex(const FName& InContext) {
+	check(IsInGameThread());
+	if (const int32* IndexPtr = GetCursorContextIndices().Find(InContext)) {
+		return *IndexPtr;
+	}
+	const int32 Index = GetCursorContextNames().Add(InContext);
+	GetCursorContextIndices().Add(InContext, Index);
+	return Index;
+}
+
+FName UCursorWidget::GetCursorContextName(int32 InIndex) {
+	return GetCursorContextNames().IsValidIndex(InIndex) ? GetCursorContextNames()[InIndex] : NAME_None;
+}
+
+TSet<FName> UCursorWidget::GetCursorContexts() const {
+	TSet<FName> Contexts;
+	for (TConstSetBitIterator<> It(CursorContextMask); It; ++It) {
+		Contexts.Add(GetCursorContextName(It.GetIndex()));
+	}
+	return Contexts;
+}
+
+bool UCursorWidget::HasCursorContext(const FName& InContext) const {
+	const int32* IndexPtr = GetCursorContextIndices().Find(InContext);
+	return IndexPtr ? HasCursorContextIndex(*IndexPtr) : false;
+}
+
+bool UCursorWidget::HasCursorContextIndex(int32 InIndex) const {
+	return CursorContextMask.IsValidIndex(InIndex) && CursorContextMask[InIndex];
+}
+
+const TBitArray<>& UCursorWidget::GetCursorContextMask() const {
+	return CursorContextMask;
+}
+
+void UCursorWidget::BeginCursorContextBatch() {
+	if (CursorContextBatchDepth == 0) {
+		CursorContextBatchStartMask = CursorContextMask;
+		CursorContextBatchEndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UCursorWidget::ActOnEndFrame);
+	}
+	CursorContextBatchDepth++;
+}
+
+void UCursorWidget::CommitCursorContextBatch() {
+	if (CursorContextBatchDepth <= 0) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("CommitCursorContextBatch called without a matching BeginCursorContextBatch."));
+		return;
+	}
+	CursorContextBatchDepth--;
+	if (CursorContextBatchDepth == 0) {
+		CloseCursorContextBatch();
+	}
+}
+
+void UCursorWidget::CloseCursorContextBatch() {
+	FCoreDelegates::OnEndFrame.Remove(CursorContextBatchEndFrameHandle);
+	CursorContextBatchEndFrameHandle.Reset();
+	CursorContextBatchDepth = 0;
+	ConditionalNotifyCursorContextsChanged(CursorContextBatchStartMask);
+}
+
+void UCursorWidget::SetCursorContextBit(int32 InIndex, bool bInValue) {
+	if (HasCursorContextIndex(InIndex) == bInValue) {
+		return;
+	}
+	const TBitArray<> OldMask = (CursorContextBatchDepth == 0 ? CursorContextMask : TBitArray<>());
+	if (!CursorContextMask.IsValidIndex(InIndex)) {
+		CursorContextMask.Add(false, InIndex + 1 - CursorContextMask.Num());
+	}
+	CursorContextMask[InIndex] = bInValue;
+	if (CursorContextBatchDepth == 0) {
+		ConditionalNotifyCursorContextsChanged(OldMask);
+	}
+}
+
+void UCursorWidget::ConditionalNotifyCursorContextsChanged(const TBitArray<>& InOldMask) {
+	// The mask only grows, pad the old mask so newly registered contexts which are unset compare equal.
+	TBitArray<> OldMask = InOldMask;
+	if (OldMask.Num() < CursorContextMask.Num()) {
+		OldMask.Add(false, CursorContextMask.Num() - OldMask.Num());
+	}
+	if (OldMask == CursorContextMask) {
+		return;
+	}
+	OnCursorContextMaskChanged.Broadcast(OldMask, CursorContextMask);
 	OnCursorContextsChanged();
 }
 
+void UCursorWidget::AddCursorContext(const FName& InContext) {
+	SetCursorContextBit(FindOrRegisterCursorContextIndex(InContext), true);
+}
+
 void UCursorWidget::RemoveCursorContext(const FName& InContext) {
-	CursorContexts.Remove(InContext);
-	OnCursorContextsChanged();
+	const int32* IndexPtr = GetCursorContextIndices().Find(InContext);
+	if (IndexPtr) {
+		SetCursorContextBit(*IndexPtr, false);
+	}
 }
 
 void UCursorWidget::AddOrRemoveCursorContext(const FName& InContext, bool bInAdd) {
@@ -142,3 +336,29 @@ void UCursorWidget::ActOnInputDeviceChanged(EInputDevices InInputDevice, int32 I
 	}
 	OnCursorContextsChanged();
 }
+
+void UCursorWidget::ActOnViewportGeometryInvalidated() {
+	CachedSlateUser.Reset();
+}
+
+void UCursorWidget::ActOnEndFrame() {
+	if (CursorContextBatchDepth > 0) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("%d cursor context batch(es) were not committed by the end of the frame, committing them."), CursorContextBatchDepth);
+	}
+	CloseCursorContextBatch();
+}
+
+// Scoped batch
+
+FScopedCursorContextBatch::FScopedCursorContextBatch(UCursorWidget* InCursorWidget) {
+	CursorWidget = InCursorWidget;
+	if (CursorWidget.IsValid()) {
+		CursorWidget->BeginCursorContextBatch();
+	}
+}
+
+FScopedCursorContextBatch::~FScopedCursorContextBatch() {
+	if (CursorWidget.IsValid()) {
+		CursorWidget->CommitCursorContextBatch();
+	}
+}
@@ -1,6 +1,7 @@
 /**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
 #include "SubHUDWidget.h"
 #include "SlateUtils.h"
+#include "GameFramework/Pawn.h"
 
 
 // Setup
@@ -39,11 +40,12 @@ bool USubHUDWidget::RegisterMenu(UMenuWidget* InMenuWidget, const FName& InRoute
 }
 
 bool USubHUDWidget::UnRegisterMenu(const FName& InRoute) {
+	// Resolve the menu before Super removes it from the registry.
+	UMenuWidget* MW = GetMenuByNavigationRoute(InRoute);
 	bool bSuccess = Super::UnRegisterMenu(InRoute);
 	
 	if (bSuccess) {
 		// Remove the binding.
-		UMenuWidget* MW = GetMenuByNavigationRoute(InRoute);
 		if (IsValid(MW)) {
 			MW->OnMenuVisibilityChanged.RemoveDynamic(this, &USubHUDWidget::ActOnMenuVisibilityChanged);
 			// One last broadcast up to the HUD.
@@ -54,6 +56,24 @@ bool USubHUDWidget::UnRegisterMenu(const FName& InRoute) {
 	return bSuccess;
 }
 
+// Pawn
+
+void USubHUDWidget::BindToPawn(APawn* InPawn) {
+	if (BoundPawn.Get() == InPawn) {
+		return;
+	}
+	if (!GetActiveRoute().IsNone()) {
+		// Close whatever the previous pawn had open.
+		NavigateToRoute(NAME_None);
+	}
+	BoundPawn = InPawn;
+	OnBoundToPawn(InPawn);
+}
+
+APawn* USubHUDWidget::GetBoundPawn() const {
+	return BoundPawn.Get();
+}
+
 // Delegates
 
 /* Respond to visibility change in a registered UMenuWidget. */
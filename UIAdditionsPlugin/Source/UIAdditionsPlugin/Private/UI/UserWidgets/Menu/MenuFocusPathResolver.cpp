@@ -0,0 +1,44 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MenuFocusPathResolver.h"
+#include "MenuWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "Slate/SObjectWidget.h"
+#include "Layout/WidgetPath.h"
+#include "Widgets/SWidget.h"
+#include "StatsUIAdditionsPlugin.h"
+
+
+const FMenuFocusPathResolution& FMenuFocusPathResolver::Resolve(const FWidgetPath& InPath) {
+	static FMenuFocusPathResolution Resolution;
+	// Dynamic casting is not available. To avoid UB on a static cast do a type comparison, against an FName made once.
+	static const FName SObjectWidgetType = TEXT("SObjectWidget");
+
+	const TSharedPtr<SWidget> LastWidget = InPath.IsValid() ? TSharedPtr<SWidget>(InPath.GetLastWidget()) : nullptr;
+	const int32 PathLength = InPath.Widgets.Num();
+	if (Resolution.FrameCounter == GFrameCounter && Resolution.LastWidget.Pin() == LastWidget && Resolution.PathLength == PathLength) {
+		INC_DWORD_STAT(STAT_MenuFocusPath_Cached);
+		return Resolution;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MenuFocusPath_Resolve);
+
+	Resolution.InnermostMenu = nullptr;
+	Resolution.LastWidget = LastWidget;
+	Resolution.PathLength = PathLength;
+	Resolution.FrameCounter = GFrameCounter;
+
+	for (int32 i = PathLength - 1; i >= 0; i--) {
+		const SWidget& WidgetX = InPath.Widgets[i].Widget.Get();
+		if (WidgetX.GetType() != SObjectWidgetType) {
+			continue;
+		}
+		UMenuWidget* MenuX = Cast<UMenuWidget>(static_cast<const SObjectWidget&>(WidgetX).GetWidgetObject());
+		if (IsValid(MenuX)) {
+			// Nothing above the innermost menu is of interest.
+			Resolution.InnermostMenu = MenuX;
+			break;
+		}
+	}
+
+	return Resolution;
+}
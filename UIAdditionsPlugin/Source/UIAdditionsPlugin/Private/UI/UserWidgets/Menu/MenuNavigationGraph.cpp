@@ -0,0 +1,202 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MenuNavigationGraph.h"
+#include "MenuWidget.h"
+#include "LogUIAdditionsPlugin.h"
+
+
+// Setup
+
+void UMenuNavigationGraph::PostLoad() {
+	Super::PostLoad();
+
+	BuildLookup();
+}
+
+#if WITH_EDITOR
+void UMenuNavigationGraph::SetGraph(const TArray<FS_MenuNavigationGraphNode>& InNodes, const TArray<FS_MenuNavigationGraphEdge>& InEdges, const TArray<FS_MenuNavigationGraphDeadRoute>& InDeadRoutes) {
+	Nodes = InNodes;
+	Edges = InEdges;
+	DeadRoutes = InDeadRoutes;
+	CyclicNodes.Reset();
+
+	const int32 NumNodes = Nodes.Num();
+	Distances.Init(UnreachableDistance, NumNodes * NumNodes);
+	NextEdges.Init(INDEX_NONE, NumNodes * NumNodes);
+
+	TArray<TArray<int32>> OutEdges;
+	OutEdges.SetNum(NumNodes);
+	for (int32 i = 0; i < Edges.Num(); i++) {
+		if (Nodes.IsValidIndex(Edges[i].FromNode) && Nodes.IsValidIndex(Edges[i].ToNode)) {
+			OutEdges[Edges[i].FromNode].Add(i);
+		}
+	}
+
+	// Breadth first from every node. Menu graphs are small, so all pairs are affordable at extraction time.
+	TArray<int32> Queue;
+	for (int32 FromX = 0; FromX < NumNodes; FromX++) {
+		Queue.Reset();
+		for (int32 EdgeX : OutEdges[FromX]) {
+			const int32 ToX = Edges[EdgeX].ToNode;
+			const int32 TableIndex = GetTableIndex(FromX, ToX);
+			if (Distances[TableIndex] == UnreachableDistance) {
+				Distances[TableIndex] = 1;
+				NextEdges[TableIndex] = EdgeX;
+				Queue.Add(ToX);
+			}
+		}
+		for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); QueueIndex++) {
+			const int32 NodeX = Queue[QueueIndex];
+			const int32 NodeTableIndex = GetTableIndex(FromX, NodeX);
+			if (Distances[NodeTableIndex] >= UnreachableDistance - 1) {
+				continue;
+			}
+			for (int32 EdgeX : OutEdges[NodeX]) {
+				const int32 ToX = Edges[EdgeX].ToNode;
+				const int32 TableIndex = GetTableIndex(FromX, ToX);
+				if (Distances[TableIndex] == UnreachableDistance) {
+					Distances[TableIndex] = Distances[NodeTableIndex] + 1;
+					// The first step is the first step towards the node we came from.
+					NextEdges[TableIndex] = NextEdges[NodeTableIndex];
+					Queue.Add(ToX);
+				}
+			}
+		}
+		if (Distances[GetTableIndex(FromX, FromX)] != UnreachableDistance) {
+			CyclicNodes.Add(FromX);
+		}
+	}
+
+	BuildLookup();
+}
+#endif // WITH_EDITOR
+
+// Lookup
+
+void UMenuNavigationGraph::BuildLookup() {
+	NodeIndicesByPath.Reset();
+	DeadRouteSet.Reset();
+
+	for (int32 i = 0; i < Nodes.Num(); i++) {
+		NodeIndicesByPath.Add(Nodes[i].MenuClass.ToSoftObjectPath().GetAssetPath(), i);
+	}
+	for (const FS_MenuNavigationGraphDeadRoute& DeadRouteX : DeadRoutes) {
+		DeadRouteSet.Add(TPair<int32, FName>(DeadRouteX.Node, DeadRouteX.Route));
+	}
+
+	if (Distances.Num() != Nodes.Num() * Nodes.Num() || NextEdges.Num() != Distances.Num()) {
+		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("%s: The distance tables do not match the nodes. Rebuild the graph with the MenuNavigationGraph commandlet."), *GetName());
+		Distances.Init(UnreachableDistance, Nodes.Num() * Nodes.Num());
+		NextEdges.Init(INDEX_NONE, Nodes.Num() * Nodes.Num());
+	}
+}
+
+int32 UMenuNavigationGraph::GetTableIndex(int32 InFromNode, int32 InToNode) const {
+	return InFromNode * Nodes.Num() + InToNode;
+}
+
+// Graph
+
+const TArray<FS_MenuNavigationGraphNode>& UMenuNavigationGraph::GetNodes() const {
+	return Nodes;
+}
+
+const TArray<FS_MenuNavigationGraphEdge>& UMenuNavigationGraph::GetEdges() const {
+	return Edges;
+}
+
+const TArray<FS_MenuNavigationGraphDeadRoute>& UMenuNavigationGraph::GetDeadRoutes() const {
+	return DeadRoutes;
+}
+
+const TArray<int32>& UMenuNavigationGraph::GetCyclicNodes() const {
+	return CyclicNodes;
+}
+
+int32 UMenuNavigationGraph::FindNode(const UClass* InMenuClass) const {
+	if (!IsValid(InMenuClass)) {
+		return INDEX_NONE;
+	}
+	const int32* NodeIndex = NodeIndicesByPath.Find(FTopLevelAssetPath(InMenuClass));
+	return NodeIndex ? *NodeIndex : INDEX_NONE;
+}
+
+TArray<int32> UMenuNavigationGraph::GetRootNodes() const {
+	TArray<bool> bHasIncoming;
+	bHasIncoming.Init(false, Nodes.Num());
+	for (const FS_MenuNavigationGraphEdge& EdgeX : Edges) {
+		if (bHasIncoming.IsValidIndex(EdgeX.ToNode) && EdgeX.ToNode != EdgeX.FromNode) {
+			bHasIncoming[EdgeX.ToNode] = true;
+		}
+	}
+	TArray<int32> RootNodes;
+	for (int32 i = 0; i < Nodes.Num(); i++) {
+		if (!bHasIncoming[i]) {
+			RootNodes.Add(i);
+		}
+	}
+	return RootNodes;
+}
+
+// Queries
+
+uint8 UMenuNavigationGraph::GetDistance(int32 InFromNode, int32 InToNode) const {
+	if (!Nodes.IsValidIndex(InFromNode) || !Nodes.IsValidIndex(InToNode)) {
+		return UnreachableDistance;
+	}
+	if (InFromNode == InToNode) {
+		return 0;
+	}
+	return Distances[GetTableIndex(InFromNode, InToNode)];
+}
+
+bool UMenuNavigationGraph::IsReachable(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass, int32 InMaxSteps) const {
+	const uint8 Distance = GetDistance(FindNode(InFromMenuClass), FindNode(InToMenuClass));
+	return Distance != UnreachableDistance && Distance <= InMaxSteps;
+}
+
+FName UMenuNavigationGraph::GetNextRoute(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass) const {
+	const int32 FromNode = FindNode(InFromMenuClass);
+	const int32 ToNode = FindNode(InToMenuClass);
+	if (!Nodes.IsValidIndex(FromNode) || !Nodes.IsValidIndex(ToNode)) {
+		return NAME_None;
+	}
+	const int32 EdgeIndex = NextEdges[GetTableIndex(FromNode, ToNode)];
+	return Edges.IsValidIndex(EdgeIndex) ? Edges[EdgeIndex].Route : NAME_None;
+}
+
+TArray<FName> UMenuNavigationGraph::GetRoutePath(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass) const {
+	TArray<FName> RoutePath;
+	int32 NodeX = FindNode(InFromMenuClass);
+	const int32 ToNode = FindNode(InToMenuClass);
+	const uint8 Distance = GetDistance(NodeX, ToNode);
+	if (Distance == UnreachableDistance) {
+		return RoutePath;
+	}
+
+	RoutePath.Reserve(Distance);
+	while (NodeX != ToNode && RoutePath.Num() < Distance) {
+		const FS_MenuNavigationGraphEdge& EdgeX = Edges[NextEdges[GetTableIndex(NodeX, ToNode)]];
+		RoutePath.Add(EdgeX.Route);
+		NodeX = EdgeX.ToNode;
+	}
+	return RoutePath;
+}
+
+bool UMenuNavigationGraph::IsDeadRoute(TSubclassOf<UMenuWidget> InMenuClass, const FName& InRoute) const {
+	return DeadRouteSet.Contains(TPair<int32, FName>(FindNode(InMenuClass), InRoute));
+}
+
+TArray<TSoftClassPtr<UMenuWidget>> UMenuNavigationGraph::GetMenusWithinSteps(TSubclassOf<UMenuWidget> InFromMenuClass, int32 InMaxSteps) const {
+	TArray<TSoftClassPtr<UMenuWidget>> MenuClasses;
+	const int32 FromNode = FindNode(InFromMenuClass);
+	if (!Nodes.IsValidIndex(FromNode)) {
+		return MenuClasses;
+	}
+	for (int32 ToX = 0; ToX < Nodes.Num(); ToX++) {
+		const uint8 Distance = Distances[GetTableIndex(FromNode, ToX)];
+		if (ToX != FromNode && Distance != UnreachableDistance && Distance <= InMaxSteps) {
+			MenuClasses.Add(Nodes[ToX].MenuClass);
+		}
+	}
+	return MenuClasses;
+}
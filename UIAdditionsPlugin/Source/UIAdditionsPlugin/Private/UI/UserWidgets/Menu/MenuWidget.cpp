@@ -1,6 +1,8 @@
 /**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
 #include "MenuWidget.h"
 #include "SubHUDWidget.h"
+#include "LazyWidget.h"
+#include "MenuFocusPathResolver.h"
 #include "MenuNavigationButtonWidget.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/PanelWidget.h"
@@ -8,13 +10,15 @@
 #include "LogUIAdditionsPlugin.h"
 #include "Widgets/SWidget.h"
 #include "SlateUtils.h"
-#include "Slate/SObjectWidget.h"
+#include "StatsUIAdditionsPlugin.h"
 #include "Blueprint/WidgetTree.h"
 #include "Layout/WidgetPath.h"
 #include "Framework/Application/SlateApplication.h"
 #include "UnrealClient.h"
 
 
+static uint32 NumMenuAncestorWalks = 0;
+
 // Setup
 
 UMenuWidget::UMenuWidget(const FObjectInitializer& InObjectInitializer)
@@ -24,13 +28,69 @@ UMenuWidget::UMenuWidget(const FObjectInitializer& InObjectInitializer)
 	SetVisibility(ESlateVisibility::Collapsed);
 }
 
+bool UMenuWidget::Initialize() {
+	// Child user widgets of the widget tree are initialized inside Super::Initialize, this menu is their context.
+	GetInitializingMenus().Push(this);
+	const bool bInitialized = Super::Initialize();
+	GetInitializingMenus().Pop(EAllowShrinking::No);
+	return bInitialized;
+}
+
+TArray<UMenuWidget*, TInlineAllocator<8>>& UMenuWidget::GetInitializingMenus() {
+	static TArray<UMenuWidget*, TInlineAllocator<8>> InitializingMenus;
+	return InitializingMenus;
+}
+
+bool UMenuWidget::IsBuiltByMenu(const UWidget* InWidget, const UMenuWidget* InMenu) {
+	if (!IsValid(InWidget) || !IsValid(InMenu) || !IsValid(InMenu->WidgetTree)) {
+		return false;
+	}
+	// Widgets are outered to the widget tree they are constructed in, a nested user widget to the tree of its parent.
+	for (const UObject* OuterX = InWidget->GetOuter(); OuterX != nullptr; OuterX = OuterX->GetOuter()) {
+		if (OuterX == InMenu->WidgetTree) {
+			return true;
+		}
+	}
+	return false;
+}
+
+UMenuWidget* UMenuWidget::FindInitializingParentMenu(const UWidget* InWidget) {
+	const TArray<UMenuWidget*, TInlineAllocator<8>>& InitializingMenus = GetInitializingMenus();
+	// A menu is on the stack itself during its own NativeOnInitialized, skip it.
+	for (int32 i = InitializingMenus.Num() - 1; i >= 0; i--) {
+		if (InitializingMenus[i] != InWidget) {
+			// Only the innermost menu can be building InWidget. Anything else is a widget created during its initialization.
+			return IsBuiltByMenu(InWidget, InitializingMenus[i]) ? InitializingMenus[i] : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+UMenuWidget* UMenuWidget::FindParentMenu(const UWidget* InWidget, bool& bOutIsInitializingParentMenu) {
+	// Prefer the menu building us, else walk up the hierarchy.
+	UMenuWidget* ParentMenu = FindInitializingParentMenu(InWidget);
+	bOutIsInitializingParentMenu = IsValid(ParentMenu);
+	if (bOutIsInitializingParentMenu) {
+		INC_DWORD_STAT(STAT_Menu_ContextRegistrations);
+		return ParentMenu;
+	}
+
+	NumMenuAncestorWalks++;
+	INC_DWORD_STAT(STAT_Menu_AncestorWalks);
+	return USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(InWidget);
+}
+
+uint32 UMenuWidget::GetNumAncestorWalks() {
+	return NumMenuAncestorWalks;
+}
+
 void UMenuWidget::NativeOnInitialized() {
 	// Bind default input actions before Super call, so BP designers can alter behavior OnInitialized if required.
 	BindRoutedInputAction(USlateUtils::InputActionNavBack, false, true, this, &UMenuWidget::ActOnNavBack);
 	
 	Super::NativeOnInitialized();
 
-	if (GetAutoRegisterToParentMenu()) {
+	if (GetAutoRegisterToParentMenu() && !IsValid(GetRegisteredParentMenu())) {
 		RegisterToParentMenu(GetAutoRegisterRoute());
 	}
 }
@@ -51,7 +111,8 @@ void UMenuWidget::NativePreConstruct() {
 void UMenuWidget::NativeConstruct() {
 	Super::NativeConstruct();
 
-	if (GetAutoRegisterToParentMenu()) {
+	// Normally registered during NativeOnInitialized already. Only a menu which was not part of a menu's widget tree at that point still has to find its parent.
+	if (GetAutoRegisterToParentMenu() && !IsValid(GetRegisteredParentMenu())) {
 		RegisterToParentMenu(GetAutoRegisterRoute());
 	}
 }
@@ -119,6 +180,8 @@ void UMenuWidget::Hide() {
 }
 
 void UMenuWidget::NativeHide() {
+	// A hidden menu is no longer on the path waiting for its lazy content.
+	PendingRoutePath.Reset();
 	// Hardcode the visibility change, it is required for external processes (menu, HUD, input).
 	SetVisibility(ESlateVisibility::Collapsed);
 	OnMenuVisibilityChanged.Broadcast(this, false);	
@@ -140,16 +203,20 @@ void UMenuWidget::RegisterToParentMenu(const FName& InRoute) {
 
 	// When a widget is added to the viewport, or to a parent widget, we want to update our registration to a parent menu.
 
-	UMenuWidget* NewParentMenuWidget = USlateUtils::FindAncestorWidgetByClass<UMenuWidget>(this);
+	bool bIsInitializingParentMenu = false;
+	UMenuWidget* NewParentMenuWidget = FindParentMenu(this, bIsInitializingParentMenu);
+	if (bIsInitializingParentMenu) {
+		InitializingParentMenu = NewParentMenuWidget;
+	}
 
 	// Do nothing if already registered.
 	if (IsValid(NewParentMenuWidget) && NewParentMenuWidget == GetRegisteredParentMenu()) {
 		return;
 	}
 
-	// Remove any old registration.
+	// Remove any old registration, by the route we are actually registered to on the old parent.
 	if (IsValid(GetRegisteredParentMenu())) {
-		GetRegisteredParentMenu()->UnRegisterMenu(InRoute);
+		GetRegisteredParentMenu()->UnRegisterMenu(GetRegisteredParentMenu()->GetNavigationRouteByMenu(this));
 	}
 
 	// Make the new registration.
@@ -175,6 +242,17 @@ void UMenuWidget::SetRegisteredParentMenu(UMenuWidget* InParentMenu) {
 	RegisteredParentMenu = InParentMenu;
 }
 
+void UMenuWidget::SetAppearPressedOnButtonsByRoute(const FName& InRoute, bool bInAppearPressed) {
+	for (UMenuNavigationButtonWidget* ButtonX : GetNavigationButtons()) {
+		if (!IsValid(ButtonX)) {
+			continue;
+		}
+		if (InRoute == ButtonX->GetNavigationRoute()) {
+			ButtonX->SetAppearPressed(bInAppearPressed, false);
+		}
+	}
+}
+
 void UMenuWidget::UnStuckFocusNavigation_Implementation(EUINavigation InNavigation) {
     RestoreFocus();
 }
@@ -234,42 +312,13 @@ void UMenuWidget::NativeOnFocusChanging(const FWeakWidgetPath& InPreviousFocusPa
 		return;
 	}	
 
-	bool bIsPreferred = false;
-	for (int32 i = InNewWidgetPath.Widgets.Num() - 1; i >= 0; i--)	{
-		TSharedPtr<SWidget> WidgetX = InNewWidgetPath.Widgets[i].Widget;
-		if (!WidgetX.IsValid()) {
-			continue;
-		}
-		/**
-		* Starting from the focused widget, up through its ancestors, we want to find the first menu widget it can be on.
-		* If the widget is on this menu, it is desired to store it as a focus preference.
-		* If it is nested in another menu, it is not desired.
-		* To know if an SWidget is a menu, we have to cast to SObjectWidget and retrieve a UserWidget from there.
-		*/
-		TSharedPtr<SObjectWidget> ObjWidgetX = nullptr;
-		// Dynamic casting is not available. To avoid UB on a static cast do a type comparison.
-		if (WidgetX->GetType() == "SObjectWidget"){
-			ObjWidgetX = StaticCastSharedPtr<SObjectWidget>(WidgetX);
-		}
-
-		if (!ObjWidgetX.IsValid()) {
-			// There is nothing to do.
-			continue;
-		}
-
-		UUserWidget* UsrWidgetX = ObjWidgetX->GetWidgetObject();
-		if (UsrWidgetX == this) {
-			// UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Newly focused widget is directly on this menu. Will prefer it for focus."));
-			// OK, it's directly on this menu.
-			bIsPreferred = true;
-			break;
-		}
-		else if (Cast<UMenuWidget>(UsrWidgetX)) {
-			// It's nested in a different menu, not preferred.
-			//UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Newly focused widget is nested in another menu on this menu. It is not preferred for this menu's focus."));
-			break;
-		}
-	}
+	/**
+	* Starting from the focused widget, up through its ancestors, we want to find the first menu widget it can be on.
+	* If the widget is on this menu, it is desired to store it as a focus preference.
+	* If it is nested in another menu, it is not desired.
+	* Every menu receives this event for the same path, so the path is resolved once and shared between them.
+	*/
+	const bool bIsPreferred = FMenuFocusPathResolver::Resolve(InNewWidgetPath).InnermostMenu.Get() == this;
 
 	if (bIsPreferred) {
 		SetPreferredFocusEntryWidget(LastNotCastedWidget);
@@ -299,7 +348,7 @@ void UMenuWidget::SetPreferredFocusEntryWidget(const TWeakPtr<SWidget>& InWidget
 	// UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: Set preferred focus entry widget to: %s"), *GetName(), (InWidget.IsValid() ? *InWidget.Pin()->GetTypeAsString() : TEXT("Null")));
 }
 
-TMap<FName, UMenuWidget*> UMenuWidget::GetMenus() const {
+const TMap<FName, UMenuWidget*>& UMenuWidget::GetMenus() const {
 	return Menus;
 }
 
@@ -312,25 +361,25 @@ bool UMenuWidget::IsAnyMenuVisible() const {
 		// Return false if self is invisible.
 		return false;
 	}
-	for (const TPair<FName, UMenuWidget*>& MenuWidgetX : GetMenus()) {
-		if (IsValid(MenuWidgetX.Value) && USlateUtils::IsVisible(MenuWidgetX.Value->GetVisibility())) {
-			return true;
+	bool bIsAnyMenuVisible = false;
+	for (auto It = VisibleMenus.CreateIterator(); It; ++It) {
+		const UMenuWidget* MenuX = It->Get();
+		if (!IsValid(MenuX) || !USlateUtils::IsVisible(MenuX->GetVisibility())) {
+			// Stale, hidden without a broadcast or destroyed.
+			It.RemoveCurrent();
+			continue;
 		}
+		bIsAnyMenuVisible = true;
+		break;
 	}
-	return false;
+	return bIsAnyMenuVisible;
 }
 
 FName UMenuWidget::GetNavigationRouteByMenu(UMenuWidget* InMenuWidget) const {
 	if (!InMenuWidget) {
 		return NAME_None;
 	}
-	for (const TPair<FName, UMenuWidget*>& MenuX : GetMenus()) {
-		if (MenuX.Value == InMenuWidget) {
-			return MenuX.Key;
-		}
-	}
-
-	return NAME_None;
+	return MenuRoutes.FindRef(InMenuWidget);
 }
 
 FName UMenuWidget::GetActiveRoute() const {
@@ -341,12 +390,7 @@ FName UMenuWidget::GetMenuRoute(UMenuWidget* InWidget) const {
 	if (!IsValid(InWidget)) {
 		return NAME_None;
 	}
-	for (const TPair<FName, UMenuWidget*> MenuX : GetMenus()) {
-		if (MenuX.Value == InWidget) {
-			return MenuX.Key;
-		}
-	}
-	return NAME_None;
+	return MenuRoutes.FindRef(InWidget);
 }
 
 UMenuWidget* UMenuWidget::NavigateTo(UMenuWidget* InWidget) {
@@ -354,18 +398,8 @@ UMenuWidget* UMenuWidget::NavigateTo(UMenuWidget* InWidget) {
 }
 
 UMenuWidget* UMenuWidget::NavigateToRoute(const FName& InRoute) {
-	
-	auto SetAppearPressedOnButtonsByRoute = [this](const FName& InRouteX, bool bInSetAppearPressedX) {
-		for (UMenuNavigationButtonWidget* ButtonX : GetNavigationButtons()) {
-			if (!IsValid(ButtonX)) {
-				continue;
-			}
-			if (InRouteX == ButtonX->GetNavigationRoute()) {
-				ButtonX->SetAppearPressed(bInSetAppearPressedX, false);
-			}
-		}		
-	};
-	
+	// Navigating elsewhere replaces a path waiting for lazy content.
+	PendingRoutePath.Reset();
 	if (!GetActiveRoute().IsNone()) {
 		// Remove the pressed visualization from any button on the previous navigation route.
 		SetAppearPressedOnButtonsByRoute(GetActiveRoute(), false);
@@ -438,6 +472,128 @@ UMenuWidget* UMenuWidget::NavigateToRoute(const FName& InRoute) {
 	}
 }
 
+UMenuWidget* UMenuWidget::NavigateToRoutePath(const TArray<FName>& InRoutePath, E_RoutePathNavigationResults& OutResult) {
+	OutResult = E_RoutePathNavigationResults::Invalid;
+	if (InRoutePath.Num() == 0) {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("%s: NavigateToRoutePath got an empty path. Aborting."), *GetName());
+		return nullptr;
+	}
+
+	struct FRouteStep {
+		UMenuWidget* Menu = nullptr;
+		FName Route = NAME_None;
+		UMenuWidget* TargetMenu = nullptr;
+	};
+
+	// Validate the whole path first. Nothing changes if any step is invalid.
+	for (const FName& RouteX : InRoutePath) {
+		if (RouteX.IsNone()) {
+			UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("%s: NavigateToRoutePath can't contain NAME_None. Use NavigateToRoute(NAME_None) to close a menu. Aborting."), *GetName());
+			return nullptr;
+		}
+	}
+	TArray<FRouteStep, TInlineAllocator<8>> Steps;
+	TArray<FName> PendingRoutes;
+	UMenuWidget* MenuX = this;
+	for (int32 i = 0; i < InRoutePath.Num(); i++) {
+		UMenuWidget* TargetMenuX = MenuX->GetMenuByNavigationRoute(InRoutePath[i]);
+		if (!IsValid(TargetMenuX)) {
+			if (!MenuX->HasUnloadedLazyContent()) {
+				UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("%s: NavigateToRoutePath found no menu on route: %s, of menu: %s. Aborting."), *GetName(), *InRoutePath[i].ToString(), *MenuX->GetName());
+				return nullptr;
+			}
+			// The menu on this route registers once the lazy content of MenuX loads, which showing MenuX can trigger.
+			PendingRoutes.Append(&InRoutePath[i], InRoutePath.Num() - i);
+			break;
+		}
+		Steps.Add({ MenuX, InRoutePath[i], TargetMenuX });
+		MenuX = TargetMenuX;
+	}
+
+	// Menus on the path are navigated now, paths they waited on are replaced. Set before showing MenuX, its content could load synchronously.
+	for (const FRouteStep& StepX : Steps) {
+		StepX.Menu->PendingRoutePath.Reset();
+	}
+	MenuX->PendingRoutePath = PendingRoutes;
+
+	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: Navigating through a route path of %d levels."), *GetName(), Steps.Num());
+
+	// Apply from the deepest level up. Descendants are in their final state before an ancestor shows, so listeners of the top level are notified once.
+	for (int32 i = Steps.Num() - 1; i >= 0; i--) {
+		const FRouteStep& StepX = Steps[i];
+		const FName OldRoute = StepX.Menu->GetActiveRoute();
+		if (OldRoute == StepX.Route) {
+			if (!USlateUtils::IsVisible(StepX.TargetMenu->GetVisibility())) {
+				StepX.TargetMenu->Show();
+			}
+			continue;
+		}
+
+		if (!OldRoute.IsNone()) {
+			StepX.Menu->SetAppearPressedOnButtonsByRoute(OldRoute, false);
+		}
+		StepX.Menu->ActiveRoute = StepX.Route;
+		StepX.Menu->SetAppearPressedOnButtonsByRoute(StepX.Route, true);
+
+		UMenuWidget* OldMenu = StepX.Menu->GetMenuByNavigationRoute(OldRoute);
+		if (IsValid(OldMenu)) {
+			OldMenu->Hide();
+		}
+		StepX.TargetMenu->Show();
+
+		// Notify blueprints.
+		StepX.Menu->AfterNavigateToRoute(OldRoute, StepX.Route);
+	}
+
+	// RestoreFocus follows the active routes down, so a single call focuses the deepest menu.
+	RestoreFocus();
+
+	// Report how far the path is active. Menus could have navigated when shown, or lazy content could have completed the path synchronously.
+	int32 NumActiveLevels = 0;
+	UMenuWidget* DeepestMenu = FindDeepestMenuOnActiveRoutePath(InRoutePath, NumActiveLevels);
+	if (NumActiveLevels == InRoutePath.Num()) {
+		OutResult = E_RoutePathNavigationResults::Navigated;
+	}
+	else if (NumActiveLevels == Steps.Num() && MenuX->PendingRoutePath.Num() > 0) {
+		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("%s: NavigateToRoutePath waits for the lazy content of menu %s to navigate route: %s."), *GetName(), *MenuX->GetName(), *MenuX->PendingRoutePath[0].ToString());
+		OutResult = E_RoutePathNavigationResults::Pending;
+	}
+	else {
+		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("%s: ActiveRoute of menu %s changed during NavigateToRoutePath, the path is active for %d of %d levels. Likely a menu requested navigation the moment it was shown."), *GetName(), *DeepestMenu->GetName(), NumActiveLevels, InRoutePath.Num());
+		MenuX->PendingRoutePath.Reset();
+		OutResult = E_RoutePathNavigationResults::Interrupted;
+	}
+	return DeepestMenu;
+}
+
+UMenuWidget* UMenuWidget::FindDeepestMenuOnActiveRoutePath(const TArray<FName>& InRoutePath, int32& OutNumLevels) const {
+	OutNumLevels = 0;
+	UMenuWidget* MenuX = const_cast<UMenuWidget*>(this);
+	for (const FName& RouteX : InRoutePath) {
+		UMenuWidget* TargetMenuX = MenuX->GetMenuByNavigationRoute(RouteX);
+		if (MenuX->GetActiveRoute() != RouteX || !IsValid(TargetMenuX) || !USlateUtils::IsVisible(TargetMenuX->GetVisibility())) {
+			break;
+		}
+		MenuX = TargetMenuX;
+		OutNumLevels++;
+	}
+	return MenuX;
+}
+
+bool UMenuWidget::HasUnloadedLazyContent() const {
+	if (!IsValid(WidgetTree)) {
+		return false;
+	}
+	bool bHasUnloadedLazyContent = false;
+	WidgetTree->ForEachWidget([&bHasUnloadedLazyContent](UWidget* InWidget) {
+		const ULazyWidget* LazyWidget = Cast<ULazyWidget>(InWidget);
+		if (IsValid(LazyWidget) && !LazyWidget->GetLazyContent().IsNull() && !IsValid(LazyWidget->GetContent())) {
+			bHasUnloadedLazyContent = true;
+		}
+	});
+	return bHasUnloadedLazyContent;
+}
+
 bool UMenuWidget::RegisterMenu(UMenuWidget* InMenuWidget, const FName& InRoute) {
 	if (!IsValid(InMenuWidget)) {
 		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("can't register an invalid / null menu. Route:"), *InRoute.ToString());
@@ -455,15 +611,32 @@ bool UMenuWidget::RegisterMenu(UMenuWidget* InMenuWidget, const FName& InRoute)
 		UE_LOG(LogUIAdditionsPlugin, Warning, TEXT("Can't register a menu already registered to this or another menu. Route: %s"), *InRoute.ToString());
 		return false;
 	}
-	if (!USlateUtils::FindAncestorWidget(InMenuWidget, this)) {
+	// The context is only trusted for the menu it was found on, and only if this menu built InMenuWidget.
+	const bool bIsBuiltByThis = InMenuWidget->InitializingParentMenu.Get() == this && IsBuiltByMenu(InMenuWidget, this);
+	if (!bIsBuiltByThis && !USlateUtils::FindAncestorWidget(InMenuWidget, this)) {
 		UE_LOG(LogUIAdditionsPlugin, Error, TEXT("Can't register a menu which is not a child of this menu. Route: %s"), *InRoute.ToString());
 		return false;
 	}
 
 	InMenuWidget->OnRequestUINavigation.AddDynamic(this, &UMenuWidget::ActOnMenuRequestedUINavigation);
+	InMenuWidget->OnNativeVisibilityChanged.AddUObject(this, &UMenuWidget::ActOnRegisteredMenuVisibilityChanged, TWeakObjectPtr<UMenuWidget>(InMenuWidget));
 	InMenuWidget->SetRegisteredParentMenu(this);
+	// The context only vouches for the ancestry at initialization.
+	InMenuWidget->InitializingParentMenu = nullptr;
 	Menus.Add(InRoute, InMenuWidget);
+	MenuRoutes.Add(InMenuWidget, InRoute);
+	if (USlateUtils::IsVisible(InMenuWidget->GetVisibility())) {
+		VisibleMenus.Add(InMenuWidget);
+	}
 	UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Registered menu: %s, on route: %s"), *InMenuWidget->GetName(), *InRoute.ToString());
+
+	// Continue a route path which waited for this menu's lazy content to load.
+	if (PendingRoutePath.Num() > 0 && PendingRoutePath[0] == InRoute) {
+		const TArray<FName> RoutePath = MoveTemp(PendingRoutePath);
+		PendingRoutePath.Reset();
+		E_RoutePathNavigationResults Result = E_RoutePathNavigationResults::Invalid;
+		NavigateToRoutePath(RoutePath, Result);
+	}
 	return true;
 }
 
@@ -472,9 +645,12 @@ bool UMenuWidget::UnRegisterMenu(const FName& InRoute) {
 	if (IsValid(ExistingMenu)) {
 		ExistingMenu->SetRegisteredParentMenu(nullptr);
 		ExistingMenu->OnRequestUINavigation.RemoveDynamic(this, &UMenuWidget::ActOnMenuRequestedUINavigation);
+		ExistingMenu->OnNativeVisibilityChanged.RemoveAll(this);
 		UE_LOG(LogUIAdditionsPlugin, VeryVerbose, TEXT("Unregistered menu: %s, on route: %s"), *ExistingMenu->GetName(), *InRoute.ToString());
 		
 		Menus.Remove(InRoute);
+		MenuRoutes.Remove(ExistingMenu);
+		VisibleMenus.Remove(ExistingMenu);
 		return true;
 	}
 	return false;
@@ -495,6 +671,18 @@ void UMenuWidget::ActOnMenuRequestedUINavigation(const FName& InRoute) {
 	NavigateToRoute(InRoute);
 }
 
+void UMenuWidget::ActOnRegisteredMenuVisibilityChanged(ESlateVisibility InVisibility, TWeakObjectPtr<UMenuWidget> InMenuWidget) {
+	if (!InMenuWidget.IsValid()) {
+		return;
+	}
+	if (USlateUtils::IsVisible(InVisibility)) {
+		VisibleMenus.Add(InMenuWidget);
+	}
+	else {
+		VisibleMenus.Remove(InMenuWidget);
+	}
+}
+
 // Delegates | Input
 
 void UMenuWidget::ActOnNavBack() {
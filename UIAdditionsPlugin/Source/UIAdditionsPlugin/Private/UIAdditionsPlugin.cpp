@@ -2,6 +2,8 @@
 #include "UIAdditionsPlugin.h"
 #include "Modules/ModuleManager.h"
 #include "DetectCurrentInputDevicePreProcessor.h"
+#include "MultiUserAnalogCursorPreProcessor.h"
+#include "MultiUserFocusChangeDispatcher.h"
 #include "LogUIAdditionsPlugin.h"
 #include "UIAdditionsPluginInstaller.h"
 #include "Templates/SharedPointer.h"
@@ -12,10 +14,16 @@ void FUIAdditionsPluginModule::StartupModule() {
 	FUIAdditionsPluginInstaller Installer = FUIAdditionsPluginInstaller();
 	Installer.RunAutomatedInstaller();
 
+	// Subscribes to Slate lazily, when the first listener is added.
+	MultiUserFocusChangeDispatcher = MakeShared<FMultiUserFocusChangeDispatcher>();
+
 	if (FSlateApplication::IsInitialized()) {
 		// Register input preprocessor
 		DetectCurrentInputDevicePreProcessor = MakeShared<FDetectCurrentInputDevicePreProcessor>();
 		FSlateApplication::Get().RegisterInputPreProcessor(DetectCurrentInputDevicePreProcessor);
+		// Registered after device detection, analog cursors used to be registered later by the HUD.
+		MultiUserAnalogCursorPreProcessor = MakeShared<FMultiUserAnalogCursorPreProcessor>();
+		FSlateApplication::Get().RegisterInputPreProcessor(MultiUserAnalogCursorPreProcessor);
 	}
 	//else {
 	//	UE_LOG(LogUIAdditionsPlugin, Error, TEXT("SlateApplication is not initialized."));
@@ -23,21 +31,32 @@ void FUIAdditionsPluginModule::StartupModule() {
 }
 
 void FUIAdditionsPluginModule::ShutdownModule() {
-	// Unregister input preprocessor
-	// TODO doesn't seem Required? At this point FSlateApplication is not initialized (anymore).
-	//if (FSlateApplication::IsInitialized()) {
-	//	if (DetectCurrentInputDevicePreProcessor.IsValid()) {
-	//		FSlateApplication::Get().UnregisterInputPreProcessor(DetectCurrentInputDevicePreProcessor);
-	//	}
-	//}
-	//else {
-	//	UE_LOG(LogUIAdditionsPlugin, Error, TEXT("SlateApplication is not initialized."));
-	//}
+	MultiUserFocusChangeDispatcher.Reset();
+
+	// Unregister input preprocessors. Slate can already be shut down at this point.
+	if (FSlateApplication::IsInitialized()) {
+		if (MultiUserAnalogCursorPreProcessor.IsValid()) {
+			FSlateApplication::Get().UnregisterInputPreProcessor(MultiUserAnalogCursorPreProcessor);
+		}
+		if (DetectCurrentInputDevicePreProcessor.IsValid()) {
+			FSlateApplication::Get().UnregisterInputPreProcessor(DetectCurrentInputDevicePreProcessor);
+		}
+	}
+	MultiUserAnalogCursorPreProcessor.Reset();
+	DetectCurrentInputDevicePreProcessor.Reset();
 }
 
 const TSharedPtr<FDetectCurrentInputDevicePreProcessor>& FUIAdditionsPluginModule::GetDetectCurrentInputDevicePreProcessor() const {
 	return DetectCurrentInputDevicePreProcessor;
 }
 
+const TSharedPtr<FMultiUserAnalogCursorPreProcessor>& FUIAdditionsPluginModule::GetMultiUserAnalogCursorPreProcessor() const {
+	return MultiUserAnalogCursorPreProcessor;
+}
+
+const TSharedPtr<FMultiUserFocusChangeDispatcher>& FUIAdditionsPluginModule::GetMultiUserFocusChangeDispatcher() const {
+	return MultiUserFocusChangeDispatcher;
+}
+
 
 IMPLEMENT_MODULE(FUIAdditionsPluginModule, UIAdditionsPlugin)
\ No newline at end of file
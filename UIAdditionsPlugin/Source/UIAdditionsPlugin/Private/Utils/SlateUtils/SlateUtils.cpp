@@ -14,6 +14,8 @@
 #include "Framework/Application/SlateUser.h"
 #include "Components/PanelWidget.h"
 #include "Components/Widget.h"
+#include "Components/WidgetSwitcher.h"
+#include "Components/ScrollBox.h"
 #include "Blueprint/UserWidget.h"
 #include "UIAdditionsPlugin.h"
 #include "Modules/ModuleManager.h"
@@ -199,6 +201,52 @@ bool USlateUtils::FindAncestorWidget(const UWidget* InWidget, const UWidget* InA
 	return FindAncestorWidget(WidgetX, InAncestorWidget, bInLookOutsideUserWidget);
 }
 
+bool USlateUtils::IsVisibleInHierarchy(const UWidget* InWidget, bool bInTestScrollRegions) {
+	if (!IsValid(InWidget)) {
+		return false;
+	}
+
+	const FGeometry& Geometry = InWidget->GetCachedGeometry();
+	const bool bCanTestScrollRegions = bInTestScrollRegions && !FVector2D(Geometry.GetLocalSize()).IsNearlyZero();
+
+	const UWidget* WidgetX = InWidget;
+	while (IsValid(WidgetX)) {
+		if (!IsVisible(WidgetX->GetVisibility())) {
+			return false;
+		}
+
+		const UWidget* ParentX = WidgetX->GetParent();
+
+		if (IsValid(ParentX)) {
+			// A switcher only displays its active widget, while the others keep their visibility.
+			const UWidgetSwitcher* Switcher = Cast<UWidgetSwitcher>(ParentX);
+			if (IsValid(Switcher) && Switcher->GetActiveWidget() != WidgetX) {
+				return false;
+			}
+
+			if (bCanTestScrollRegions) {
+				const UScrollBox* ScrollBox = Cast<UScrollBox>(ParentX);
+				if (IsValid(ScrollBox)) {
+					const FGeometry& ScrollBoxGeometry = ScrollBox->GetCachedGeometry();
+					if (!FVector2D(ScrollBoxGeometry.GetLocalSize()).IsNearlyZero()
+						&& !FSlateRect::DoRectanglesIntersect(Geometry.GetLayoutBoundingRect(), ScrollBoxGeometry.GetLayoutBoundingRect())
+						) {
+						return false;
+					}
+				}
+			}
+		}
+		else {
+			// If a parent is not valid, we get the outer UUserWidget. From there we can also get a new parent.
+			ParentX = WidgetX->GetTypedOuter<UUserWidget>();
+		}
+
+		WidgetX = ParentX;
+	}
+
+	return true;
+}
+
 // Conversion
 
 void USlateUtils::GetKeyAndCharCodes(const FKey& InKey, bool& bOutHasKeyCode, uint32& OutKeyCode, bool& bOutHasCharCode, uint32& OutCharCode) {
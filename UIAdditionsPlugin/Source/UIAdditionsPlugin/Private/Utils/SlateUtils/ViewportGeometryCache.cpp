@@ -0,0 +1,91 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "ViewportGeometryCache.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "UnrealClient.h"
+#include "Widgets/SViewport.h"
+
+
+// Setup
+
+FViewportGeometryCache::~FViewportGeometryCache() {
+	Reset();
+}
+
+void FViewportGeometryCache::Reset() {
+	if (ViewportResizedHandle.IsValid()) {
+		FViewport::ViewportResizedEvent.Remove(ViewportResizedHandle);
+		ViewportResizedHandle.Reset();
+	}
+	if (UGameViewportClient* GameViewportClient = CachedGameViewportClient.Get()) {
+		GameViewportClient->OnPlayerAdded().Remove(PlayerAddedHandle);
+		GameViewportClient->OnPlayerRemoved().Remove(PlayerRemovedHandle);
+	}
+	PlayerAddedHandle.Reset();
+	PlayerRemovedHandle.Reset();
+	CachedGameViewportClient = nullptr;
+	bIsGeometryValid = false;
+}
+
+// Cache
+
+UGameViewportClient* FViewportGeometryCache::GetGameViewportClient(const UObject* InWorldContextObject) {
+	if (UGameViewportClient* GameViewportClient = CachedGameViewportClient.Get()) {
+		return GameViewportClient;
+	}
+	if (!IsValid(InWorldContextObject) || !GEngine) {
+		return nullptr;
+	}
+
+	UWorld* World = GEngine->GetWorldFromContextObject(InWorldContextObject, EGetWorldErrorMode::ReturnNull);
+	UGameViewportClient* GameViewportClient = IsValid(World) ? World->GetGameViewport() : nullptr;
+	if (!IsValid(GameViewportClient)) {
+		return nullptr;
+	}
+
+	// A previous game viewport client is gone, don't keep its bindings around.
+	Reset();
+	ViewportResizedHandle = FViewport::ViewportResizedEvent.AddRaw(this, &FViewportGeometryCache::ActOnViewportResized);
+	// The split screen layout changes when players are added or removed.
+	PlayerAddedHandle = GameViewportClient->OnPlayerAdded().AddRaw(this, &FViewportGeometryCache::ActOnPlayerAddedOrRemoved);
+	PlayerRemovedHandle = GameViewportClient->OnPlayerRemoved().AddRaw(this, &FViewportGeometryCache::ActOnPlayerAddedOrRemoved);
+	CachedGameViewportClient = GameViewportClient;
+	Invalidate();
+	return GameViewportClient;
+}
+
+void FViewportGeometryCache::Validate() {
+	// The geometry is absolute, so it is also stale when the window moved. Comparing the viewport widget rect is cheap and covers that.
+	const UGameViewportClient* GameViewportClient = CachedGameViewportClient.Get();
+	const TSharedPtr<SViewport> ViewportWidget = IsValid(GameViewportClient) ? GameViewportClient->GetGameViewportWidget() : nullptr;
+	const FSlateRect ViewportRect = ViewportWidget.IsValid() ? ViewportWidget->GetCachedGeometry().GetLayoutBoundingRect() : FSlateRect();
+	if (ViewportRect != CachedViewportRect) {
+		CachedViewportRect = ViewportRect;
+		Invalidate();
+	}
+}
+
+const FGeometry& FViewportGeometryCache::GetGeometry(TFunctionRef<FGeometry()> InBuildGeometry) {
+	Validate();
+	if (!bIsGeometryValid) {
+		CachedGeometry = InBuildGeometry();
+		bIsGeometryValid = true;
+	}
+	return CachedGeometry;
+}
+
+void FViewportGeometryCache::Invalidate() {
+	bIsGeometryValid = false;
+	OnInvalidated.Broadcast();
+}
+
+// Delegates
+
+void FViewportGeometryCache::ActOnViewportResized(FViewport* InViewport, uint32 InUnused) {
+	Invalidate();
+}
+
+void FViewportGeometryCache::ActOnPlayerAddedOrRemoved(int32 InPlayerIndex) {
+	Invalidate();
+}
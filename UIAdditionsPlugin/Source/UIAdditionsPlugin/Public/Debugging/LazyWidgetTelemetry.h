@@ -0,0 +1,115 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULazyWidget;
+
+
+/* Timings of a single content load by a lazy widget. Times are FPlatformTime::Seconds, 0 if the stage was not reached. */
+struct FLazyWidgetLoadRecord {
+
+	/* Id returned by FLazyWidgetTelemetry::BeginLoad. Used to tell if the slot of the record was reused since. */
+	int32 Id = INDEX_NONE;
+
+	FString LazyWidget;
+
+	/* Class of the nearest menu the lazy widget lives in, if any. */
+	FString Menu;
+
+	FString Content;
+
+	bool bAsync = false;
+
+	double RequestTime = 0;
+
+	double LoadedTime = 0;
+
+	double ConstructedTime = 0;
+
+	/* Game thread time spent in CreateWidget. */
+	double CreateWidgetSeconds = 0;
+
+	/* Packages loaded synchronously while loading and creating the content. */
+	int32 SyncLoads = 0;
+
+	bool bCancelled = false;
+
+};
+
+
+/**
+* Records a FLazyWidgetLoadRecord for the latest content loads by lazy widgets (up to MaxRecords, oldest are overwritten), and updates the lazy stats (stat UIAdditionsPlugin).
+* Records can be exported to CSV with the console command "UIAdditionsPlugin.LazyWidget.ExportTelemetry [FilePath]", which does not require rendering.
+* "UIAdditionsPlugin.LazyWidget.ResetTelemetry" clears the records and the lazy load counters, to measure a single scenario.
+* Recording is controlled by the console variable "UIAdditionsPlugin.LazyWidget.Telemetry", off by default.
+*/
+class UIADDITIONSPLUGIN_API FLazyWidgetTelemetry {
+
+private:
+
+	static const int32 MaxRecords = 1024;
+
+	/* Ring buffer, the record with id X lives at X % MaxRecords. */
+	TArray<FLazyWidgetLoadRecord> Records;
+
+	int32 NextRecordId = 0;
+
+	/* Incremented by every synchronous package load on the game thread, used to attribute sync loads to a lazy load. */
+	int32 SyncLoadCounter = 0;
+
+	FDateTime SessionStartTime;
+
+	FDelegateHandle SyncLoadPackageHandle;
+
+protected:
+
+public:
+
+private:
+
+	FLazyWidgetTelemetry();
+
+	~FLazyWidgetTelemetry();
+
+	void ActOnSyncLoadPackage(const FString& InPackageName);
+
+	/* Returns the record of InRecordId, or nullptr if it was not recorded or was overwritten since. */
+	FLazyWidgetLoadRecord* FindRecord(int32 InRecordId);
+
+protected:
+
+public:
+
+	// Setup
+
+	static FLazyWidgetTelemetry& Get();
+
+	// Records
+
+	/* Starts a record for a content load by InLazyWidget. Returns its id, or INDEX_NONE if telemetry is disabled. */
+	int32 BeginLoad(const ULazyWidget* InLazyWidget, bool bInAsync);
+
+	void MarkLoaded(int32 InRecordIndex);
+
+	void MarkConstructed(int32 InRecordIndex, double InCreateWidgetSeconds, int32 InSyncLoads);
+
+	void MarkCancelled(int32 InRecordIndex);
+
+	int32 GetSyncLoadCounter() const;
+
+	/* The kept records, oldest first. */
+	TArray<FLazyWidgetLoadRecord> GetRecords() const;
+
+	/* Clears the records and resets the lazy load counters of the stats. Loads in progress are no longer recorded. */
+	void Reset();
+
+	// Export
+
+	/* Default export path, unique per session. */
+	FString GetDefaultExportFilePath() const;
+
+	/* Writes all records to a CSV file. Returns true if written. */
+	bool ExportCSV(const FString& InFilePath) const;
+
+};
@@ -0,0 +1,59 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+
+/* View in game with "stat UIAdditionsPlugin". */
+DECLARE_STATS_GROUP(TEXT("UIAdditionsPlugin"), STATGROUP_UIAdditionsPlugin, STATCAT_Advanced);
+
+// Lazy
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lazy CreateWidget"), STAT_LazyWidget_CreateWidget, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Loads Requested"), STAT_LazyWidget_LoadsRequested, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Loads Constructed"), STAT_LazyWidget_LoadsConstructed, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Loads Cancelled"), STAT_LazyWidget_LoadsCancelled, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Sync Loads Triggered"), STAT_LazyWidget_SyncLoads, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Last Request To Loaded (ms)"), STAT_LazyWidget_RequestToLoadedMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Lazy Last Loaded To Constructed (ms)"), STAT_LazyWidget_LoadedToConstructedMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// Defer Paint
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Paint Groups"), STAT_DeferPaint_Groups, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Paint Painted"), STAT_DeferPaint_Painted, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Paint Culled"), STAT_DeferPaint_Culled, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// Cursor
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cursor Hit Index Rebuild"), STAT_AnalogCursor_HitIndexRebuild, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cursor Hit Index Layout Check"), STAT_AnalogCursor_HitIndexLayoutCheck, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cursor Hit Index Entries"), STAT_AnalogCursor_HitIndexEntries, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// World Cursor
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Cursor Trace Tick"), STAT_WorldCursorTrace_Tick, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("World Cursor Traces"), STAT_WorldCursorTrace_Traces, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("World Cursor Traces Cached"), STAT_WorldCursorTrace_Cached, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// Menu
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Menu Focus Path Resolve"), STAT_MenuFocusPath_Resolve, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Menu Focus Path Cached"), STAT_MenuFocusPath_Cached, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Menu Registrations From Context"), STAT_Menu_ContextRegistrations, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Menu Registration Ancestor Walks"), STAT_Menu_AncestorWalks, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// HUD
+
+// Startup timings of the primary player's HUD.
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("HUD Startup Load (ms)"), STAT_HUDStartup_LoadMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("HUD Startup Construct (ms)"), STAT_HUDStartup_ConstructMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("HUD Startup Attach (ms)"), STAT_HUDStartup_AttachMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("HUD Startup Total (ms)"), STAT_HUDStartup_TotalMs, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Tick"), STAT_HUDCore_Tick, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("HUD Ticks"), STAT_HUDCore_Ticks, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+
+// Focus
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Focus Changes Dispatched"), STAT_FocusDispatcher_Events, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Focus Listeners Notified"), STAT_FocusDispatcher_ListenersNotified, STATGROUP_UIAdditionsPlugin, UIADDITIONSPLUGIN_API);
@@ -0,0 +1,77 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+#include "Templates/SharedPointer.h"
+
+class SWidget;
+class FWidgetPath;
+class FWeakWidgetPath;
+struct FFocusEvent;
+
+
+DECLARE_DELEGATE_FiveParams(FOnUserFocusChanging, const FFocusEvent&, const FWeakWidgetPath&, const TSharedPtr<SWidget>&, const FWidgetPath&, const TSharedPtr<SWidget>&);
+
+
+/**
+* A single subscriber to FSlateApplication::OnFocusChanging which routes every focus change only to the listeners of the Slate user it belongs to (FFocusEvent::GetUser).
+* Instead of every HUD binding globally and handling the focus changes of all users, listeners are stored in a dense array indexed by user index.
+* A focus change costs O(listeners of that user), no matter how many local players listen.
+* Subscribes to Slate when the first listener is added, and unsubscribes when the last one is removed.
+* Owned by the module (FUIAdditionsPluginModule).
+*/
+class UIADDITIONSPLUGIN_API FMultiUserFocusChangeDispatcher {
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FMultiUserFocusChangeDispatcherTest;
+#endif
+
+private:
+
+	struct FListener {
+
+		FDelegateHandle Handle;
+
+		FOnUserFocusChanging Delegate;
+
+	};
+
+	/* Indexed by Slate user index. */
+	TArray<TArray<FListener, TInlineAllocator<2>>> Listeners;
+
+	int32 NumListeners = 0;
+
+	FDelegateHandle FocusChangingHandle;
+
+protected:
+
+public:
+
+private:
+
+	void Subscribe();
+
+	void Unsubscribe();
+
+	void ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWidgetPath& InOldFocusedWidgetPath, const TSharedPtr<SWidget>& InOldFocusedWidget, const FWidgetPath& InNewFocusedWidgetPath, const TSharedPtr<SWidget>& InNewFocusedWidget);
+
+protected:
+
+public:
+
+	// Setup
+
+	~FMultiUserFocusChangeDispatcher();
+
+	// Listeners
+
+	/* Adds a listener for focus changes of the Slate user InUserIndex. Returns the handle to remove it with. */
+	FDelegateHandle AddListener(int32 InUserIndex, const FOnUserFocusChanging& InDelegate);
+
+	/* Removes a listener added by AddListener. */
+	void RemoveListener(int32 InUserIndex, FDelegateHandle InHandle);
+
+	int32 GetNumListeners(int32 InUserIndex) const;
+
+};
@@ -0,0 +1,90 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Vector2D.h"
+#include "Framework/Application/AnalogCursor.h"
+
+
+struct FAnalogCursorSample {
+
+	/* Time in seconds the sample was received. */
+	double Time = 0.0;
+
+	/* Dead zone adjusted stick value. */
+	FVector2D Value = FVector2D::ZeroVector;
+
+};
+
+/**
+* Fixed-step integrator for analog cursor motion.
+* Buffered, timestamped stick samples are applied at their timestamps while the speed and offset are simulated at a fixed internal rate.
+* The resulting trajectory does not depend on the frame rate, and samples received between two frames still affect the motion.
+* Has no dependency on Slate state or time sources (time is passed in), so it is deterministic and can be driven headless.
+*/
+class UIADDITIONSPLUGIN_API FAnalogCursorIntegrator {
+
+private:
+
+	/* Pending samples, ordered by time. */
+	TArray<FAnalogCursorSample> Samples;
+
+	/* Stick value held between samples. */
+	FVector2D Input = FVector2D::ZeroVector;
+
+	FVector2D Speed = FVector2D::ZeroVector;
+
+	double SimulatedTime = 0.0;
+
+	bool bHasSimulatedTime = false;
+
+	AnalogCursorMode::Type Mode = AnalogCursorMode::Accelerated;
+
+	float Acceleration = 1000.f;
+
+	float MaxSpeed = 1500.f;
+
+	/* Simulation steps per second. */
+	float StepRate = 240.f;
+
+	/* Simulated time does not lag further behind than this, so a long hitch does not turn into a burst of motion. */
+	double MaxCatchUpTime = 0.1;
+
+protected:
+
+public:
+
+private:
+
+	/* Simulates a single step of InStepTime with the held input, returns the displacement. */
+	FVector2D Step(float InStepTime);
+
+protected:
+
+public:
+
+	void SetParameters(AnalogCursorMode::Type InMode, float InAcceleration, float InMaxSpeed);
+
+	float GetStepRate() const;
+
+	void SetStepRate(float InStepRate);
+
+	/* Buffers a sample. Samples older than the simulated time are applied at the start of the next step. */
+	void AddSample(double InTime, const FVector2D& InValue);
+
+	/* Simulates fixed steps up to InTime and returns the total displacement, scaled by InSpeedMultiplier. The remainder smaller than a step is carried to the next call. */
+	FVector2D Advance(double InTime, float InSpeedMultiplier = 1.f);
+
+	/* Moves the simulated time to InTime without simulating, keeping the held input. Use while the cursor is idle. */
+	void SyncTime(double InTime);
+
+	/* Clears samples and input and restarts at InTime with InSpeed, so motion continues from a speed simulated elsewhere. */
+	void Reset(double InTime, const FVector2D& InSpeed = FVector2D::ZeroVector);
+
+	const FVector2D& GetSpeed() const;
+
+	const FVector2D& GetInput() const;
+
+	bool HasPendingSamples() const;
+
+};
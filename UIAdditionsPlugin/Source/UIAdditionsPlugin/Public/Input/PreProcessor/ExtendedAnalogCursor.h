@@ -8,7 +8,13 @@
 #include "Math/Vector2D.h"
 #include "Templates/SharedPointer.h" 
 #include "GenericPlatform/ICursor.h"
+#include "Layout/Geometry.h"
 #include "CursorScreenSpace.h"
+#include "AnalogCursorIntegrator.h"
+#include "ViewportGeometryCache.h"
+
+class FInteractableWidgetHitIndex;
+class UGameViewportClient;
 
 
 class UIADDITIONSPLUGIN_API FExtendedAnalogCursor : public FAnalogCursor {
@@ -26,6 +32,19 @@ private:
 	// Stored Slate cursor position for quick access
 	FVector2D CurrentPosition = FVector2D(0, 0);
 
+	/* True once CurrentPosition holds a position set by this cursor. Used to detect idle ticks. */
+	bool bHasCurrentPosition = false;
+
+	// Cached geometry
+
+	/* Geometry of the relevant screen space (CursorScreenSpace) the cursor is clamped to. */
+	FViewportGeometryCache ClampGeometryCache;
+
+	/* Position the cursor is frozen to, computed once per freeze and again after the clamp geometry was invalidated. */
+	FVector2D FreezeAnchor = FVector2D::ZeroVector;
+
+	bool bIsFreezeAnchorValid = false;
+
 	// If true, the cursor will be frozen to the center of the player screen during its tick.
 	bool bFreezeCursorToCenterOfScreen = false;
 
@@ -34,6 +53,20 @@ private:
 	/* If we should process a NavSelect button as a cursor click or not. This should be true after using cursor movement and false after navigating by Slate navigation keys. */
 	bool bProcessNavSelectEvent = false;
 
+	/* If true, motion is simulated by Integrator at a fixed rate from timestamped samples, instead of once per tick with the frame delta time. */
+	bool bUseFixedStepIntegration = false;
+
+	FAnalogCursorIntegrator Integrator;
+
+	/* Optional spatial index of interactable widgets. When valid it replaces the hit test used for sticky slowdown and enables magnetism. */
+	TSharedPtr<FInteractableWidgetHitIndex> InteractableWidgetHitIndex = nullptr;
+
+	/* How fast the cursor is pulled to the nearest interactable widget while the stick is idle. 0 disables magnetism. Requires an InteractableWidgetHitIndex. */
+	float MagnetismStrength = 0.f;
+
+	/* Max distance from the cursor to an interactable widget for magnetism to apply. */
+	float MagnetismRadius = 64.f;
+
 protected:
 
 public:
@@ -48,6 +81,21 @@ private:
 
 protected:
 
+	/* Returns the stick values of AnalogStick, rescaled so the dead zone edge maps to 0. */
+	FVector2D GetDeadZoneAdjustedAnalogValues() const;
+
+	/* Returns the cached game viewport client of the local player. */
+	UGameViewportClient* GetGameViewportClient();
+
+	/* Returns the geometry of the relevant screen space to clamp the cursor to, rebuilding it if it is no longer valid. */
+	const FGeometry& GetClampGeometry();
+
+	/* The freeze anchor is derived from the same viewport state as the clamp geometry. */
+	void ActOnClampGeometryInvalidated();
+
+	/* Returns true if the cursor is over an interactable widget, for sticky slowdown. Uses the InteractableWidgetHitIndex if valid, else a hit test. */
+	bool IsOverInteractableWidget(FSlateApplication& InSlateApp, const TSharedRef<FSlateUser> InSlateUser, const FVector2D& InPosition) const;
+
 	/* Return if the input key is relevant to the analog cursor movement. */
 	virtual bool IsRelevantCursorMovementKey(const FKey InKey) const;
 
@@ -84,6 +132,37 @@ public:
 
 	void SetCursorScreenSpace(E_CursorScreenSpace InCursorScreenSpace);
 
+	/* Forces the clamp geometry and freeze anchor to be rebuilt on the next cursor update. Resizing the viewport and adding / removing split screen players already does this. */
+	void InvalidateClampGeometry();
+
 	void SetStick(EAnalogStick InNewAnalogStick);
 
+	// Integration
+
+	bool GetUseFixedStepIntegration() const;
+
+	/* Opt in to frame rate independent motion, simulated at GetFixedStepRate steps per second. */
+	void SetUseFixedStepIntegration(bool bInUseFixedStepIntegration);
+
+	float GetFixedStepRate() const;
+
+	void SetFixedStepRate(float InStepRate);
+
+	// Interactable widgets
+
+	const TSharedPtr<FInteractableWidgetHitIndex>& GetInteractableWidgetHitIndex() const;
+
+	void SetInteractableWidgetHitIndex(TSharedPtr<FInteractableWidgetHitIndex> InInteractableWidgetHitIndex);
+
+	float GetMagnetismStrength() const;
+
+	void SetMagnetismStrength(float InMagnetismStrength);
+
+	float GetMagnetismRadius() const;
+
+	void SetMagnetismRadius(float InMagnetismRadius);
+
+	/* Moves the cursor to the center of the nearest interactable widget within InMaxDistance. Requires an InteractableWidgetHitIndex. Returns true if the cursor was moved. */
+	bool SnapToNearestInteractableWidget(float InMaxDistance);
+
 };
@@ -0,0 +1,133 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/SlateRect.h"
+#include "Layout/Visibility.h"
+#include "Math/Vector2D.h"
+#include "Templates/SharedPointer.h"
+
+class SWidget;
+
+
+/* A hit test visible widget. Entries are stored in paint order, so for equal layers a later entry is painted above an earlier one. */
+struct FInteractableWidgetHitEntry {
+
+	TWeakPtr<SWidget> Widget = nullptr;
+
+	/* Absolute rect of the widget, already clipped by its clipping ancestors. */
+	FSlateRect Rect = FSlateRect();
+
+	/* Layer the widget was painted on during the last frame. */
+	int32 LayerId = 0;
+
+	/* Index of the entry of this widget or its nearest interactable ancestor, INDEX_NONE if neither is interactable. Same as a hit test, which is interactable if any widget on the hit path is. */
+	int32 InteractableIndex = INDEX_NONE;
+
+};
+
+/* Layout state of a visited widget, compared to detect layout changes without rebuilding. */
+struct FInteractableWidgetHitNode {
+
+	TWeakPtr<SWidget> Widget = nullptr;
+
+	FSlateRect LayoutRect = FSlateRect();
+
+	EVisibility Visibility = EVisibility::Visible;
+
+	int32 NumChildren = 0;
+
+};
+
+/**
+* Uniform grid of the absolute rects of the hit test visible widgets found below a set of root widgets (usually the Sub HUDs of a player).
+* Used by the analog cursor to answer "is the cursor over something interactable" without a full hierarchical hit test every frame,
+* and to find the nearest interactable widget for magnetism / snapping.
+* Like a hit test only the topmost widget at a position counts, so interactable widgets occluded by other hit test visible widgets are filtered out.
+* The index is built from the cached geometry and layers of the last frame. Slate has no event for layout changes, so at every rebuild interval the
+* visited widgets are compared to their current rect, visibility and child count. That check is a flat pass over the visited widgets without
+* allocations, the index is only rebuilt if something changed or it was marked dirty.
+*/
+class UIADDITIONSPLUGIN_API FInteractableWidgetHitIndex {
+
+private:
+
+	TArray<TWeakPtr<SWidget>> Roots;
+
+	TArray<FInteractableWidgetHitEntry> Entries;
+
+	/* Every widget visited during the last rebuild, including the hidden and clipped ones which could become visible. */
+	TArray<FInteractableWidgetHitNode> Nodes;
+
+	/* Maps a grid cell to indices into Entries. */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float CellSize = 128.f;
+
+	/* Interval in seconds at which the layout is checked for changes. 0 or less only rebuilds when marked dirty. */
+	float RebuildInterval = 0.25f;
+
+	double LastLayoutCheckTime = 0.0;
+
+	bool bIsDirty = true;
+
+protected:
+
+public:
+
+private:
+
+	void CollectInteractableWidgets(const TSharedRef<SWidget>& InWidget, const FSlateRect& InClipRect, int32 InInteractableIndex);
+
+	/* Returns true if any visited widget changed its rect, visibility or children since the last rebuild. */
+	bool HasLayoutChanged() const;
+
+	FIntPoint GetCellForPosition(const FVector2D& InAbsolutePosition) const;
+
+	/* Returns the index of the topmost entry at the absolute position, or INDEX_NONE. */
+	int32 FindTopmostEntry(const FVector2D& InAbsolutePosition) const;
+
+protected:
+
+public:
+
+	// Roots
+
+	void AddRoot(const TSharedRef<SWidget>& InRoot);
+
+	void RemoveRoot(const TSharedRef<SWidget>& InRoot);
+
+	void ClearRoots();
+
+	// Building
+
+	/* Forces a rebuild during the next ConditionalRebuild. Call this when widgets are shown / hidden / moved. */
+	void MarkDirty();
+
+	bool IsDirty() const;
+
+	/* Rebuilds if the index is dirty, or if the rebuild interval elapsed and the layout changed. */
+	void ConditionalRebuild();
+
+	void Rebuild();
+
+	float GetRebuildInterval() const;
+
+	void SetRebuildInterval(float InRebuildInterval);
+
+	float GetCellSize() const;
+
+	/* Changing the cell size marks the index dirty. */
+	void SetCellSize(float InCellSize);
+
+	// Queries
+
+	int32 GetNumEntries() const;
+
+	/* Returns true if the topmost widget at the absolute position is interactable or inside an interactable widget. */
+	bool IsInteractableAtPosition(const FVector2D& InAbsolutePosition) const;
+
+	/* Returns the interactable widget whose rect is closest to the absolute position within InMaxDistance, or nullptr. OutCenter receives the absolute center of its rect. Widgets whose center is occluded are skipped. */
+	TSharedPtr<SWidget> FindNearest(const FVector2D& InAbsolutePosition, float InMaxDistance, FVector2D& OutCenter) const;
+
+};
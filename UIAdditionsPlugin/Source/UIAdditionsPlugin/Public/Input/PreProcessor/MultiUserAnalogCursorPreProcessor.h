@@ -0,0 +1,88 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Templates/SharedPointer.h"
+
+class FExtendedAnalogCursor;
+class FSlateApplication;
+class ICursor;
+struct FAnalogInputEvent;
+struct FKeyEvent;
+struct FPointerEvent;
+struct FInputEvent;
+
+
+/**
+* A single input preprocessor which multiplexes the analog cursors of all local players.
+* Instead of registering one preprocessor per player (each filtering every event by user index), cursors are stored in a dense array indexed by their owner user index.
+* Events are routed straight to the cursor of the user which caused them, and all cursors are ticked in one loop.
+* Slots are verified during the tick, cursors are refiled if their owner user index changed.
+* A cursor without a valid owner user index, or whose slot is taken by another cursor, is kept unfiled. It is not ticked or routed events until a refile finds it a slot.
+* Owned and registered by the module (FUIAdditionsPluginModule).
+*/
+class UIADDITIONSPLUGIN_API FMultiUserAnalogCursorPreProcessor : public IInputProcessor {
+
+private:
+
+	/* Indexed by the cursor's owner user index. Slots of users without a cursor are nullptr. */
+	TArray<TSharedPtr<FExtendedAnalogCursor>> Cursors;
+
+	/* Cursors which could not be filed by their owner user index. */
+	TArray<TSharedPtr<FExtendedAnalogCursor>> UnfiledCursors;
+
+protected:
+
+public:
+
+private:
+
+	/* Returns the cursor of the user which caused the event, or nullptr. */
+	FExtendedAnalogCursor* FindCursorForEvent(const FInputEvent& InInputEvent) const;
+
+	/* Files the cursor in the slot of its owner user index, or keeps it unfiled if it has no valid index or the slot is taken. */
+	void FileCursor(const TSharedPtr<FExtendedAnalogCursor>& InCursor, bool bInWasUnfiled);
+
+	/* True if a cursor is in a stale slot, or an unfiled cursor can be filed. */
+	bool NeedsRefile() const;
+
+protected:
+
+public:
+
+	// Cursors
+
+	/* Adds the cursor to the slot of its owner user index, replacing any cursor already there. */
+	void AddCursor(const TSharedRef<FExtendedAnalogCursor>& InCursor);
+
+	void RemoveCursor(const TSharedRef<FExtendedAnalogCursor>& InCursor);
+
+	TSharedPtr<FExtendedAnalogCursor> FindCursor(int32 InUserIndex) const;
+
+	/* The number of cursors, including unfiled cursors. */
+	int32 GetNumCursors() const;
+
+	int32 GetNumUnfiledCursors() const;
+
+	/* Moves every cursor to the slot of its current owner user index. Controller ids can be remapped when players are added or removed.
+	* A cursor already in the slot of its owner keeps it, a cursor which can not be filed is logged and kept unfiled. */
+	void RefileCursors();
+
+	// Tick
+
+	virtual void Tick(const float InDeltaTime, FSlateApplication& InSlateApp, TSharedRef<ICursor> InCursor) override;
+
+	// Input
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& InSlateApp, const FKeyEvent& InKeyEvent) override;
+
+	virtual bool HandleKeyUpEvent(FSlateApplication& InSlateApp, const FKeyEvent& InKeyEvent) override;
+
+	virtual bool HandleAnalogInputEvent(FSlateApplication& InSlateApp, const FAnalogInputEvent& InAnalogInputEvent) override;
+
+	virtual bool HandleMouseMoveEvent(FSlateApplication& InSlateApp, const FPointerEvent& InMouseEvent) override;
+
+	virtual const TCHAR* GetDebugName() const override;
+
+};
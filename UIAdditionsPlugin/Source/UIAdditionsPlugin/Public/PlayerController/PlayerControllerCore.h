@@ -8,6 +8,8 @@
 
 
 class UHUDCorePlayerControllerComponent;
+class AHUDCore;
+struct FStreamableHandle;
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReceivedPlayer);
@@ -22,6 +24,10 @@ class UIADDITIONSPLUGIN_API APlayerControllerCore : public APlayerController {
 
 private:
 
+	// HUD
+
+	TSharedPtr<FStreamableHandle> HUDWidgetClassesHandle = nullptr;
+
 protected:
 
 	// Setup | Components
@@ -29,6 +35,12 @@ protected:
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
 		UHUDCorePlayerControllerComponent* HUDCorePlayerControllerComponent = nullptr;
 
+	// HUD
+
+	/* If true, starts streaming the sub HUD widget classes of the game mode's AHUDCore class as soon as this controller receives its player, ahead of the HUD's BeginPlay. The classes are held until the HUD startup completed, from then on the HUD holds its pawn HUD classes itself. */
+	UPROPERTY(EditAnywhere, Category = "HUD")
+		bool bPreloadHUDWidgetClasses = false;
+
 public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Delegates")
@@ -46,4 +58,13 @@ public:
 
 	virtual void ReceivedPlayer() override;
 
+	// HUD
+
+	/* Starts streaming the sub HUD widget classes configured on InHUDClass. Call during map loading to have them ready before the HUD starts. */
+	UFUNCTION(BlueprintCallable, Category = "HUD")
+		void PreloadHUDWidgetClasses(TSubclassOf<AHUDCore> InHUDClass);
+
+	/* Stops holding the classes streamed by PreloadHUDWidgetClasses. Called by AHUDCore once its startup completed, its sub HUDs reference their classes and it holds the pawn HUD classes from then on. */
+	void ReleasePreloadedHUDWidgetClasses();
+
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "UIAdditionsPluginSettings.generated.h"
+
+
+/* Project settings for the UI Additions Plugin. */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "UI Additions Plugin"))
+class UIADDITIONSPLUGIN_API UUIAdditionsPluginSettings : public UDeveloperSettings {
+	GENERATED_BODY()
+
+private:
+
+	// Lazy
+
+	/**
+	* Estimated memory (MB) the content of lazy widgets may hold per player. 
+	* When exceeded, loaded content which is not visible is evicted, lowest priority and least recently visible first.
+	* 0 disables the budget.
+	*/
+	UPROPERTY(Config, EditAnywhere, Category = "Lazy", meta = (ClampMin = "0"))
+		int32 LazyContentMemoryBudgetMB = 0;
+
+protected:
+
+public:
+
+private:
+
+protected:
+
+public:
+
+	// Setup
+
+	//~ Begin UDeveloperSettings Interface
+	virtual FName GetCategoryName() const override;
+	//~ End UDeveloperSettings Interface
+
+	// Lazy
+
+	/* Returns the lazy content memory budget per player in bytes. 0 means there is no budget. */
+	int64 GetLazyContentMemoryBudgetBytes() const;
+
+};
@@ -0,0 +1,136 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LazyWidgetSubsystem.generated.h"
+
+class ULazyWidget;
+class UMenuWidget;
+class UUserWidget;
+
+
+/* Accounting of the content loaded by a single lazy widget. */
+struct FLazyContentMemoryEntry {
+
+	TWeakObjectPtr<ULazyWidget> LazyWidget = nullptr;
+
+	/* The nearest menu the lazy widget lives in, if any. */
+	TWeakObjectPtr<UMenuWidget> Menu = nullptr;
+
+	/* Estimate of the content on its own, including all resources it references. */
+	int64 EstimatedBytes = 0;
+
+	/* Estimate of the content widgets, excluding the resources, which are shared with other entries. */
+	int64 WidgetBytes = 0;
+
+	/* Resources (textures) referenced by the content, counted once in the total no matter how many entries reference them. */
+	TArray<TObjectKey<UObject>> Resources;
+
+	/* The last time the content was visible. Stamped when the content becomes visible and again when it is hidden. */
+	double LastVisibleTime = 0;
+
+	bool bIsVisible = true;
+
+};
+
+
+/* A resource referenced by the content of one or more lazy widgets. */
+struct FLazyContentSharedResource {
+
+	int64 Bytes = 0;
+
+	int32 RefCount = 0;
+
+};
+
+
+/**
+* Keeps track of the content loaded by lazy widgets owned by a player, and enforces a memory budget on it.
+* Memory is an estimate: the UObject footprint of the content widget tree and the resources of textures referenced by its images.
+* When the budget is exceeded, content hidden by one of its load conditions (see ULazyWidget::IsHiddenByLoadCondition) is evicted, by lowest eviction priority, then by least recently visible.
+*/
+UCLASS()
+class UIADDITIONSPLUGIN_API ULazyWidgetSubsystem : public ULocalPlayerSubsystem {
+	GENERATED_BODY()
+
+private:
+
+	// Lazy
+
+	TMap<TObjectKey<ULazyWidget>, FLazyContentMemoryEntry> Entries;
+
+	TMap<TObjectKey<UObject>, FLazyContentSharedResource> SharedResources;
+
+	int64 TotalEstimatedBytes = 0;
+
+	int64 MemoryBudgetBytes = 0;
+
+	/* Prevents eviction from re-entering through UnloadContent. */
+	bool bIsEnforcingMemoryBudget = false;
+
+protected:
+
+public:
+
+private:
+
+	/* Adds the widgets of InContent and those of nested user widgets to OutWidgetBytes, and the resources they reference to OutResourceBytes. */
+	static void CollectContentMemory(UUserWidget* InContent, int64& OutWidgetBytes, TMap<UObject*, int64>& OutResourceBytes);
+
+	/* Evicts content until the budget is respected. InLoadingLazyWidget is never evicted, as it just loaded for being visible. */
+	void EnforceMemoryBudget(const ULazyWidget* InLoadingLazyWidget);
+
+protected:
+
+public:
+
+	// Setup
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& InCollection) override;
+	//~ End USubsystem Interface
+
+	// Lazy
+
+	/* Returns an estimate of the memory held by InContent, its nested user widgets and the textures they reference. Each texture is counted once. */
+	static int64 EstimateContentMemory(UUserWidget* InContent);
+
+	/* Called by a lazy widget after its content was set. */
+	void RegisterLoadedContent(ULazyWidget* InLazyWidget);
+
+	/* Called by a lazy widget before its content is cleared. */
+	void UnRegisterLoadedContent(ULazyWidget* InLazyWidget);
+
+	/* Marks the content of InLazyWidget as visible now, which is used to find the least recently visible content. */
+	void MarkContentVisible(ULazyWidget* InLazyWidget);
+
+	/* Marks the content of InLazyWidget as hidden now. It was visible up to this moment, so it starts aging for eviction from here. */
+	void MarkContentHidden(ULazyWidget* InLazyWidget);
+
+	/* True while content is being evicted. Evicted lazy widgets leave collecting garbage to the subsystem, which does it once after evicting. */
+	bool IsEnforcingMemoryBudget() const;
+
+	/* Estimated memory held by the content of all lazy widgets of this player. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		int64 GetTotalEstimatedMemory() const;
+
+	/* Estimated memory held by the content of InLazyWidget, including resources it shares with other content. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		int64 GetEstimatedMemoryForLazyWidget(const ULazyWidget* InLazyWidget) const;
+
+	/* Estimated memory held by the content of lazy widgets in InMenu, resources shared between them counted once. If bInIncludeSubMenus, content of menus nested in InMenu is included. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		int64 GetEstimatedMemoryForMenu(const UMenuWidget* InMenu, bool bInIncludeSubMenus = true) const;
+
+	/* Memory budget in bytes for lazy content of this player. 0 means there is no budget. Defaults to the project setting. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		int64 GetMemoryBudget() const;
+
+	/* Memory budget in bytes for lazy content of this player. 0 means there is no budget. Applied immediately. */
+	UFUNCTION(BlueprintCallable, Category = "Lazy")
+		void SetMemoryBudget(int64 InMemoryBudgetBytes);
+
+};
@@ -0,0 +1,158 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+
+#include "WorldCursorTraceSubsystem.generated.h"
+
+class APlayerController;
+
+
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_WorldCursorTraceSettings {
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		float TraceDistance = 100000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		bool bTraceComplex = false;
+
+	/* If true, the trace runs asynchronously and its result is available one frame later. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		bool bAsync = false;
+
+	/* While cursor and camera are unchanged, a result is reused for at most this many seconds, so moving objects are still picked up. Below 0 reuses it until cursor or camera change. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		float MaxCachedResultAge = 0.2f;
+
+};
+
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_WorldCursorTraceResult {
+	GENERATED_BODY()
+
+	/* False until the first trace for the player completed. */
+	UPROPERTY(BlueprintReadOnly)
+		bool bIsValid = false;
+
+	UPROPERTY(BlueprintReadOnly)
+		bool bBlockingHit = false;
+
+	UPROPERTY(BlueprintReadOnly)
+		FHitResult Hit;
+
+	/* Viewport pixel position the trace was made from. */
+	UPROPERTY(BlueprintReadOnly)
+		FVector2D ScreenPosition = FVector2D::ZeroVector;
+
+};
+
+/* State of a single registered player. */
+struct FWorldCursorTraceEntry {
+
+	TWeakObjectPtr<APlayerController> PlayerController = nullptr;
+
+	FS_WorldCursorTraceSettings Settings;
+
+	FS_WorldCursorTraceResult Result;
+
+	// Cache key of Result
+
+	FVector2D TracedScreenPosition = FVector2D::ZeroVector;
+
+	FVector TracedCameraLocation = FVector::ZeroVector;
+
+	FRotator TracedCameraRotation = FRotator::ZeroRotator;
+
+	double TracedTime = 0.0;
+
+	bool bForceTrace = true;
+
+	FTraceHandle PendingAsyncTrace;
+
+};
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWorldCursorTraceUpdated, APlayerController*, InPlayerController, const FS_WorldCursorTraceResult&, InResult);
+
+
+/**
+* Traces from the cursor of every registered player into the world, in one step per frame.
+* Players whose pawn desires a centered world cursor (UWorldCursorModifierComponent) trace from the center of their screen, others from their Slate cursor.
+* Results are reused while cursor and camera are unchanged, and traces can optionally run asynchronously.
+* Intended to replace per-pawn / per-widget traces that each run every frame.
+*/
+UCLASS()
+class UIADDITIONSPLUGIN_API UWorldCursorTraceSubsystem : public UTickableWorldSubsystem {
+	GENERATED_BODY()
+
+private:
+
+	TArray<FWorldCursorTraceEntry> Entries;
+
+protected:
+
+public:
+
+	/* Broadcast when a new trace result is available for a player. Not broadcast for reused results. */
+	UPROPERTY(BlueprintAssignable, Category = "Delegates")
+		FOnWorldCursorTraceUpdated OnWorldCursorTraceUpdated;
+
+private:
+
+	FWorldCursorTraceEntry* FindEntry(const APlayerController* InPlayerController);
+
+	const FWorldCursorTraceEntry* FindEntry(const APlayerController* InPlayerController) const;
+
+	/* Returns the viewport pixel position the player's world cursor is at. */
+	bool GetWorldCursorScreenPosition(APlayerController* InPlayerController, FVector2D& OutScreenPosition) const;
+
+	/* Collects a finished async trace into the entry. Returns true if a result was collected. */
+	bool CollectAsyncTrace(FWorldCursorTraceEntry& InEntry);
+
+	void SetResult(FWorldCursorTraceEntry& InEntry, const FHitResult* InHit);
+
+	/* Traces for the entry if needed. Returns true if its result was updated, the caller broadcasts it. */
+	bool TickEntry(FWorldCursorTraceEntry& InEntry, double InTime);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override;
+
+public:
+
+	// Tick
+
+	virtual void Tick(float InDeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// Trace
+
+	/* Starts tracing from the player's world cursor every frame. Registering again updates the settings. */
+	UFUNCTION(BlueprintCallable, Category = "WorldCursor")
+		void RegisterPlayer(APlayerController* InPlayerController, const FS_WorldCursorTraceSettings& InSettings);
+
+	UFUNCTION(BlueprintCallable, Category = "WorldCursor")
+		void UnRegisterPlayer(APlayerController* InPlayerController);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "WorldCursor")
+		bool IsPlayerRegistered(const APlayerController* InPlayerController) const;
+
+	/* Returns the latest result for the player. Returns false if the player is not registered or has no result yet. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "WorldCursor")
+		bool GetTraceResult(const APlayerController* InPlayerController, FS_WorldCursorTraceResult& OutResult) const;
+
+	/* Forces a new trace for the player during the next tick, for example after the world changed in a way the cache can't detect. */
+	UFUNCTION(BlueprintCallable, Category = "WorldCursor")
+		void InvalidateTraceResult(const APlayerController* InPlayerController);
+
+};
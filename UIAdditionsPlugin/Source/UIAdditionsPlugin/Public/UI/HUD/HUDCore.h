@@ -4,6 +4,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
 #include "Templates/SharedPointer.h"
+#include "PawnHUDPool.h"
+#include "HUDStartupTimings.h"
+#include "PlayerControllerInputModes.h"
 
 #include "HUDCore.generated.h"
 
@@ -11,12 +14,19 @@ class USubHUDWidget;
 class AController;
 class UCursorWidget;
 class FExtendedAnalogCursor;
+class FInteractableWidgetHitIndex;
 class SWidget;
 class FWidgetPath;
 class FWeakWidgetPath;
+class FViewport;
+class UHUDCorePlayerControllerComponent;
+struct FStreamableHandle;
 struct FFocusEvent;
 
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHUDStartupCompleted, const FS_HUDStartupTimings&, InTimings);
+
+
 /*
 * HUD actor which implements "sub" HUD widgets. 
 * Takes control over PlayerController input modes.
@@ -36,6 +46,9 @@ private:
 	static const int32 ZIndexPlayerViewportHUD = 3;
 	static const int32 ZIndexCursor = 4;
 
+	/* Tick request held while the cursor is frozen, the hardware cursor has to be synchronized every frame. */
+	static const FName TickRequestFrozenMouse;
+
 	// Setup
 
 	UPROPERTY()
@@ -46,12 +59,42 @@ private:
 
 	UPROPERTY()
 		TMap<APawn*, USubHUDWidget*> PawnHUDs;
+
+	/* Idle pawn HUDs by widget class, used if bPoolPawnHUDs. */
+	UPROPERTY()
+		TMap<TSubclassOf<USubHUDWidget>, FS_PawnHUDPool> PawnHUDPools;
+
+	TSharedPtr<FStreamableHandle> PawnHUDWidgetClassesHandle = nullptr;
+
+	// Startup
+
+	TSharedPtr<FStreamableHandle> HUDWidgetClassesHandle = nullptr;
+
+	UPROPERTY(Transient)
+		FS_HUDStartupTimings StartupTimings;
+
+	double StartupStartTime = 0;
+
+	/* Next construction step of the startup, see StartupConstructWidget. */
+	int32 StartupConstructionStep = 0;
+
+	bool bIsStartupComplete = false;
+
+	// Tick
+
+	/* Reasons the HUD currently has per frame work for, used if bEventDrivenTick. */
+	TSet<FName> TickRequests;
+
+	/* True if a blueprint implements Event Tick or overrides TickUpdateMouseLocation. Such a HUD always ticks. */
+	bool bHasScriptTick = false;
 	
 	// Cursor
 
 	//UPROPERTY()
 	TSharedPtr<FExtendedAnalogCursor> AnalogCursor = nullptr;
 
+	TSharedPtr<FInteractableWidgetHitIndex> InteractableWidgetHitIndex = nullptr;
+
 	UPROPERTY()
 		UCursorWidget* CustomCursorWidget = nullptr;
 
@@ -61,6 +104,40 @@ private:
 	UPROPERTY()
 		bool bPawnDesiresCenteredWorldCursor = false;
 
+	/* Position the hardware cursor is frozen to, computed once per freeze and again after the viewport changed. */
+	UPROPERTY(Transient)
+		FVector2D MouseFreezeAnchor = FVector2D::ZeroVector;
+
+	UPROPERTY(Transient)
+		bool bIsMouseFreezeAnchorValid = false;
+
+	// Input
+
+	/* Set by RequestUpdateInputMode. The input mode and cursor contexts are applied once at the end of the frame. */
+	bool bIsInputModeDirty = false;
+
+	/* False until UpdateInputMode ran at least once. Until then the cursor freeze is applied even if it looks unchanged. */
+	bool bHasAppliedInputMode = false;
+
+	/* The input mode UpdateInputMode last applied, and the component it was applied to. The component's own state is not trusted to tell if applying can be skipped. */
+	TOptional<E_PlayerControllerInputModes> AppliedInputMode;
+
+	TWeakObjectPtr<UHUDCorePlayerControllerComponent> AppliedInputModeComponent = nullptr;
+
+	TWeakObjectPtr<UHUDCorePlayerControllerComponent> CachedHUDCorePlayerControllerComponent = nullptr;
+
+	FDelegateHandle EndFrameDelegateHandle;
+
+	// Focus
+
+	/* Guards ActOnFocusChanging against re entry while this HUD restores focus. Kept per HUD, so focus changes of different players don't suppress each other. */
+	bool bIsRestoringFocus = false;
+
+	/* Listener on the module's FMultiUserFocusChangeDispatcher, for the Slate user of the owning player. */
+	FDelegateHandle FocusChangingListenerHandle;
+
+	int32 FocusChangingListenerUserIndex = INDEX_NONE;
+
 	// Sub HUD tracking
 
 	UPROPERTY()
@@ -85,8 +162,70 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "HUD")
 		TSoftClassPtr<USubHUDWidget> PawnHUDWidgetClass = nullptr;
 
+	/* Pawn HUD widget classes for specific pawn classes and their subclasses. Pawns without an entry use PawnHUDWidgetClass. */
+	UPROPERTY(EditAnywhere, Category = "HUD")
+		TMap<TSoftClassPtr<APawn>, TSoftClassPtr<USubHUDWidget>> PawnHUDWidgetClassOverrides;
+
+	/* If true, pawn HUDs are taken from a pool and bound to the possessed pawn, instead of created per pawn. Their widget classes are loaded asynchronously during BeginPlay, the pawn HUD of an already possessed pawn is shown once they are loaded. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Pool")
+		bool bPoolPawnHUDs = false;
+
+	/* Max idle pawn HUDs kept per widget class. Released pawn HUDs beyond this are removed. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Pool", meta = (EditCondition = "bPoolPawnHUDs", ClampMin = 0))
+		int32 PawnHUDPoolSize = 2;
+
+	/* Pawn HUDs created per widget class as soon as the widget classes are loaded, so possession does not construct widgets. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Pool", meta = (EditCondition = "bPoolPawnHUDs", ClampMin = 0))
+		int32 PawnHUDPoolWarmupCount = 1;
+
+	// Startup
+
+	/* If true, BeginPlay does not load the sub HUD widget classes synchronously. They are streamed (or already preloaded by APlayerControllerCore), then the sub HUDs are constructed and attached once loaded. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Startup")
+		bool bAsyncStartup = false;
+
+	/* Game thread time in ms the async startup may spend constructing sub HUDs per frame. Remaining widgets are constructed next frame. 0 constructs all in one frame. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Startup", meta = (EditCondition = "bAsyncStartup", ClampMin = 0))
+		float StartupConstructionBudgetMs = 0.f;
+
+	// Tick
+
+	/* If true, the HUD does not tick by default. It only ticks while there is a tick request (RequestTick), such as a frozen cursor, so an idle HUD costs nothing per frame. */
+	UPROPERTY(EditAnywhere, Category = "HUD|Tick")
+		bool bEventDrivenTick = false;
+
+	// Cursor
+
+	/* If true, the analog cursor simulates its motion at a fixed rate from timestamped stick samples, making it independent of the frame rate. */
+	UPROPERTY(EditAnywhere, Category = "Cursor")
+		bool bUseFixedStepCursorIntegration = false;
+
+	/* Simulation steps per second of the analog cursor when bUseFixedStepCursorIntegration is true. */
+	UPROPERTY(EditAnywhere, Category = "Cursor", meta = (EditCondition = "bUseFixedStepCursorIntegration", ClampMin = 1))
+		float CursorIntegrationStepRate = 240.f;
+
+	/* If true, the analog cursor uses a spatial index of the interactable widgets on the Sub HUDs for sticky slowdown, instead of a hit test every frame. Also required for magnetism and snapping. Recommended for dense menus. */
+	UPROPERTY(EditAnywhere, Category = "Cursor")
+		bool bUseInteractableWidgetHitIndex = false;
+
+	/* Interval in seconds at which the interactable widget index compares the widgets it visited to their current layout, it is only rebuilt if something changed. Menu visibility changes always rebuild it. */
+	UPROPERTY(EditAnywhere, Category = "Cursor", meta = (EditCondition = "bUseInteractableWidgetHitIndex", ClampMin = 0))
+		float InteractableWidgetHitIndexRebuildInterval = 0.25f;
+
+	/* How fast the analog cursor is pulled to the nearest interactable widget while the stick is idle. 0 disables magnetism. */
+	UPROPERTY(EditAnywhere, Category = "Cursor", meta = (EditCondition = "bUseInteractableWidgetHitIndex", ClampMin = 0))
+		float CursorMagnetismStrength = 0.f;
+
+	/* Max distance from the analog cursor to an interactable widget for magnetism to apply. */
+	UPROPERTY(EditAnywhere, Category = "Cursor", meta = (EditCondition = "bUseInteractableWidgetHitIndex", ClampMin = 0))
+		float CursorMagnetismRadius = 64.f;
+
 public:
 
+	/* Broadcast once the sub HUDs are attached, with the time spent per startup phase. */
+	UPROPERTY(BlueprintAssignable, Category = "Delegates")
+		FOnHUDStartupCompleted OnHUDStartupCompleted;
+
 private:
 
 protected:
@@ -94,11 +233,41 @@ protected:
 	// Setup
 	
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type InEndPlayReason) override;
 	
+	// Startup
+
+	/* Collects the soft paths of every configured sub HUD widget class. */
+	void GetHUDWidgetClassPaths(TArray<FSoftObjectPath>& OutWidgetClassPaths) const;
+
+	/* Collects the soft paths of PawnHUDWidgetClass and PawnHUDWidgetClassOverrides. */
+	void GetPawnHUDWidgetClassPaths(TArray<FSoftObjectPath>& OutWidgetClassPaths) const;
+
+	/* Load phase, the startup timings start here. Loads the player screen and viewport HUD classes synchronously, or streams all sub HUD classes if bAsyncStartup. */
+	void StartupLoadWidgetClasses();
+
+	void ActOnStartupWidgetClassesLoaded();
+
+	/* Construct phase. Runs construction steps until done, or until StartupConstructionBudgetMs is spent and continues next frame. Then attaches. */
+	void StartupConstructWidgets();
+
+	/* Creates the sub HUD widget of a single construction step. Returns false if there are no steps left. Override to construct more widgets during startup, steps the base class does not handle return false. */
+	virtual bool StartupConstructWidget(int32 InStep);
+
+	/* Attach phase. Adds the constructed sub HUDs to the screen, binds them and the possessed pawn, then reports the timings. */
+	void StartupAttachWidgets();
+
+	/* Holds the loaded pawn HUD widget classes in PawnHUDWidgetClassesHandle, so releasing the startup and controller preloads does not drop the classes of pawn HUDs which are not created yet. */
+	void RetainLoadedPawnHUDWidgetClasses();
+
 	// Tick
 
 	virtual void Tick(float InDeltaSeconds) override;
 
+	/* Enables the actor tick if it is not event driven, if there is a tick request or if a blueprint ticks. Disables it otherwise. */
+	void UpdateTickEnabled();
+
 	/* This is called during Tick. Default behavior is for it to set the owning playercontroller's mouse location (not analog cursor or widget) to the center of the screen if GetFreezeCursorToCenterOfScreen() && app is running in the foreground. A hardware cursor can not exactly be locked to a position, so this tick synchronizes it. An alternative you could be looking for could be using an analog cursor. */
 	UFUNCTION(BlueprintNativeEvent, Category = "HUDCore|Input")
 	void TickUpdateMouseLocation();
@@ -111,11 +280,47 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|SubHUD")
 		USubHUDWidget* FindOrCreatePawnHUD(APawn* InPawn);
 
+	/* Returns the pawn HUD widget class for InPawn, from PawnHUDWidgetClassOverrides or PawnHUDWidgetClass. Loads synchronously if it was not preloaded. */
+	TSubclassOf<USubHUDWidget> GetPawnHUDWidgetClass(const APawn* InPawn) const;
+
+	/* Creates a pawn HUD on the player screen. Pooled pawn HUDs are collapsed while idle. Override to place pawn HUDs elsewhere. */
+	virtual USubHUDWidget* CreatePawnHUD(TSubclassOf<USubHUDWidget> InWidgetClass);
+
+	/* Loads every configured pawn HUD widget class asynchronously, then warms the pools. */
+	void PreloadPawnHUDWidgetClasses();
+
+	/* True while PreloadPawnHUDWidgetClasses is loading. Creating a pawn HUD meanwhile would load its class synchronously, flushing the preload. */
+	bool IsPawnHUDPreloadPending() const;
+
+	/* Warms the pools, then shows the pawn HUD of the possessed pawn if it was deferred for the preload. */
+	void ActOnPawnHUDWidgetClassesPreloaded();
+
+	/* Finds or creates the pawn HUD of the possessed InPawn, binds it and shows it. */
+	void ShowPawnHUD(APawn* InPawn);
+
+	/* Fills the pool of every loaded pawn HUD widget class up to PawnHUDPoolWarmupCount. */
+	void WarmupPawnHUDPools();
+
+	/* Takes an idle pawn HUD of InWidgetClass from its pool, or creates one if the pool is empty. */
+	USubHUDWidget* AcquirePawnHUD(TSubclassOf<USubHUDWidget> InWidgetClass);
+
+	/* Unbinds InPawnHUD from its pawn and returns it to its pool, or removes it if the pool is full. */
+	void ReleasePawnHUD(USubHUDWidget* InPawnHUD);
+
 	// Input
 
 	/* Calculates what the current input mode should be for the playercontroller, based on tracked visibility of menus inside the Sub HUDs, then sets it (UHUDCorePlayerControllerComponent). Automatically sets SetFreezeCursorToCenterOfScreen. Explanation: In input mode UI / Game + UI you should not have a frozen cursor (because there are widgets to interact with), and in input mode Game you might but only if desired. */
 	virtual void UpdateInputMode();
 
+	/* Marks the input mode and cursor contexts dirty. They are computed and applied once at the end of the frame, no matter how many visibility changes requested it. Binds to the end of the frame until then. */
+	void RequestUpdateInputMode();
+
+	/* Gets the HUDCorePlayerControllerComponent of the owning player controller, cached after the first lookup. */
+	UHUDCorePlayerControllerComponent* GetHUDCorePlayerControllerComponent();
+
+	/* Applies the contexts the HUD manages on the custom cursor widget, as a single batch. */
+	void UpdateCursorContexts();
+
 	// Cursor
 
 	bool GetPawnDesiresCenteredWorldCursor() const;
@@ -125,10 +330,29 @@ protected:
 	/* Sets bFreezeCursorToCenterOfScreen, then requests freezing on the analog cursor and custom cursor. Does not lock the hardware cursor, but its position can be attempted to synchronize to a position during tick.  */
 	virtual void SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenterOfScreen);
 
+	/* Makes TickUpdateMouseLocation recompute the position to freeze the hardware cursor to. */
+	void InvalidateMouseFreezeAnchor();
+
+	/* Sets the visible Sub HUDs as roots of the interactable widget index, if it is used. */
+	void UpdateInteractableWidgetHitIndexRoots();
+
+	// Focus
+
+	/* Listens to focus changes of the owning player's Slate user only. Moves the listener if the player's user index changed. */
+	void RegisterFocusChangingListener();
+
+	void UnregisterFocusChangingListener();
+
 	// Delegates
 
 	void ActOnFocusChanging(const FFocusEvent& InFocusEvent, const FWeakWidgetPath& InOldFocusedWidgetPath, const TSharedPtr<SWidget>& InOldFocusedWidget, const FWidgetPath& InNewFocusedWidgetPath, const TSharedPtr<SWidget>& InNewFocusedWidget);
 
+	void ActOnViewportResized(FViewport* InViewport, uint32 InUnused);
+
+	void ActOnPlayerAddedOrRemoved(int32 InPlayerIndex);
+
+	void ActOnEndFrame();
+
 	// Delegates | Panels
 
 	UFUNCTION()
@@ -160,6 +384,31 @@ public:
 
 	virtual void BeginDestroy();
 
+	// Startup
+
+	/* Starts streaming the sub HUD widget classes configured on InHUDClass, so a HUD spawned later does not wait on them. Keep the handle alive until the HUD started. */
+	static TSharedPtr<FStreamableHandle> PreloadHUDWidgetClasses(TSubclassOf<AHUDCore> InHUDClass);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|Startup")
+		bool GetIsStartupComplete() const;
+
+	/* Time spent per startup phase. Only complete once GetIsStartupComplete. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|Startup")
+		const FS_HUDStartupTimings& GetStartupTimings() const;
+
+	// Tick
+
+	/* Keeps the HUD ticking while InReason is requested, if bEventDrivenTick. For example while an animation driven by the HUD plays. */
+	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|Tick")
+		void RequestTick(FName InReason);
+
+	/* Releases a tick request made by RequestTick. The HUD stops ticking once no requests remain. */
+	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|Tick")
+		void ReleaseTick(FName InReason);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|Tick")
+		bool IsTickRequested(FName InReason) const;
+
 	// Panels
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
@@ -183,9 +432,31 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
 		USubHUDWidget* FindPawnHUD(APawn* InPawn) const;
 
+	/* Removes the pawn HUD of InPawn, or returns it to the pool if bPoolPawnHUDs. */
 	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|SubHUD")
 		void DestroyPawnHUD(APawn* InPawn);
 
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
+		bool GetPoolPawnHUDs() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
+		int32 GetPawnHUDPoolSize() const;
+
+	/* Max idle pawn HUDs kept per widget class. Shrinks pools which exceed the new size. */
+	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|SubHUD")
+		void SetPawnHUDPoolSize(int32 InPawnHUDPoolSize);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
+		int32 GetPawnHUDPoolWarmupCount() const;
+
+	/* Pawn HUDs to keep ready per widget class. Warms the pools right away if the widget classes are loaded. */
+	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|SubHUD")
+		void SetPawnHUDPoolWarmupCount(int32 InPawnHUDPoolWarmupCount);
+
+	/* Number of idle pawn HUDs of InWidgetClass in the pool. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|SubHUD")
+		int32 GetNumPooledPawnHUDs(TSubclassOf<USubHUDWidget> InWidgetClass) const;
+
 	// Cursor
 
 	FORCEINLINE TSharedPtr<FExtendedAnalogCursor> GetAnalogCursor() const;
@@ -211,6 +482,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|Cursor")
 		FVector2D GetCursorPosition() const;
 
+	/* Moves the analog cursor to the center of the nearest interactable widget within InMaxDistance. Requires the analog cursor and bUseInteractableWidgetHitIndex. Returns true if the cursor was moved. */
+	UFUNCTION(BlueprintCallable, Category = "HUD|HUDCore|Cursor")
+		bool SnapCursorToNearestInteractableWidget(float InMaxDistance = 200.f);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "HUD|HUDCore|Cursor")
 		UCursorWidget* GetCustomCursorWidget() const;
 
@@ -0,0 +1,68 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class USubHUDWidget;
+class SWidget;
+class FWidgetPath;
+class FWeakWidgetPath;
+
+
+/* The HUD layers of a player a focus path crosses. */
+struct FHUDFocusPathLayers {
+
+	bool bIsValid = false;
+
+	bool bContainsViewportHUD = false;
+
+	bool bContainsScreenHUD = false;
+
+	bool bContainsPawnHUD = false;
+
+	bool ContainsAnyHUD() const {
+		return bContainsViewportHUD || bContainsScreenHUD || bContainsPawnHUD;
+	}
+
+};
+
+/**
+* Resolves which sub HUDs of a player a focus path crosses, in a single walk of the path.
+* The slate widgets of the sub HUDs are retrieved once on construction, so resolving does not call TakeWidget or walk the path once per HUD layer.
+* Meant to live for the duration of a single focus event.
+*/
+class UIADDITIONSPLUGIN_API FHUDFocusPathResolver {
+
+private:
+
+	TSharedPtr<SWidget> ViewportHUDWidget = nullptr;
+
+	TSharedPtr<SWidget> ScreenHUDWidget = nullptr;
+
+	TSharedPtr<SWidget> PawnHUDWidget = nullptr;
+
+protected:
+
+public:
+
+private:
+
+	/* Tags InWidget on OutLayers. Returns true once every known HUD layer has been found, so the walk can stop early. */
+	bool TagWidget(const SWidget* InWidget, FHUDFocusPathLayers& OutLayers) const;
+
+protected:
+
+public:
+
+	// Setup
+
+	FHUDFocusPathResolver(const USubHUDWidget* InViewportHUD, const USubHUDWidget* InScreenHUD, const USubHUDWidget* InPawnHUD);
+
+	// Resolve
+
+	FHUDFocusPathLayers Resolve(const FWidgetPath& InPath) const;
+
+	FHUDFocusPathLayers Resolve(const FWeakWidgetPath& InPath) const;
+
+};
@@ -0,0 +1,41 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HUDStartupTimings.generated.h"
+
+
+/* Time spent per phase of the HUD startup, from AHUDCore::BeginPlay until the sub HUDs are attached and interactive. */
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_HUDStartupTimings {
+	GENERATED_BODY()
+
+	/* Wall time until the sub HUD widget classes were loaded. Near 0 if they were preloaded. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		float LoadMs = 0.f;
+
+	/* Game thread time spent creating the sub HUD widgets, summed over all frames the construction was sliced over. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		float ConstructMs = 0.f;
+
+	/* Game thread time spent adding the sub HUD widgets to the screen and binding them. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		float AttachMs = 0.f;
+
+	/* Wall time from BeginPlay until the HUD was interactive. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		float TotalMs = 0.f;
+
+	/* Frames the construction was spread over. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		int32 ConstructFrames = 0;
+
+	/* True if all widget classes were loaded before BeginPlay, for example by APlayerControllerCore. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		bool bWasPreloaded = false;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		bool bWasAsync = false;
+
+};
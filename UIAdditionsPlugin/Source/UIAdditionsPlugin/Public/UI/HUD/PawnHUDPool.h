@@ -0,0 +1,19 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PawnHUDPool.generated.h"
+
+class USubHUDWidget;
+
+
+/* Idle pawn HUD instances of a single widget class, collapsed on the player screen and ready to be bound to a pawn. */
+USTRUCT()
+struct UIADDITIONSPLUGIN_API FS_PawnHUDPool {
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<USubHUDWidget*> Instances;
+
+};
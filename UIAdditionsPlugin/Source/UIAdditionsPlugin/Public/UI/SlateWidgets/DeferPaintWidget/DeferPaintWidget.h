@@ -34,6 +34,34 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Appearance")
 		FMargin Padding = FMargin(0, 0);
 
+	// Paint
+
+	/**
+	* Paint the content together with other batched deferred content of the same DeferredLayer, instead of on deferred layers of its own.
+	* Content of the same deferred layer can share draw batches, but should not overlap.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Paint")
+		bool bBatchDeferredPainting = false;
+
+	/* Batched deferred content is painted in ascending order of this layer. */
+	UPROPERTY(EditAnywhere, Category = "Paint", meta = (EditCondition = "bBatchDeferredPainting"))
+		int32 DeferredLayer = 0;
+
+	/**
+	* Skip the deferred paint when the content is fully outside of the culling rect of the regular paint (the clipping of ancestors).
+	* Disable if the content is deferred to draw outside of the clipping of its ancestors.
+	* Collapsed, hidden and fully transparent content is always skipped.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Paint")
+		bool bCullDeferredPainting = true;
+
+	/**
+	* Cache the draw elements of the content and replay them until the content is invalidated. Meant for static overlays (tooltips, frame decorations).
+	* Retained content is only painted by the deferred pass.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Paint")
+		bool bRetainDeferredContent = false;
+
 protected:
 
 	// Content
@@ -106,4 +134,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Appearance")
 		void SetPadding(FMargin InPadding);
 
+	// Paint
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Paint")
+		bool GetBatchDeferredPainting() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Paint")
+		void SetBatchDeferredPainting(bool bInBatchDeferredPainting);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Paint")
+		int32 GetDeferredLayer() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Paint")
+		void SetDeferredLayer(int32 InDeferredLayer);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Paint")
+		bool GetCullDeferredPainting() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Paint")
+		void SetCullDeferredPainting(bool bInCullDeferredPainting);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Paint")
+		bool GetRetainDeferredContent() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Paint")
+		void SetRetainDeferredContent(bool bInRetainDeferredContent);
+
+	/* Forces retained content to repaint, for changes which do not invalidate the content themselves (material parameters for example). */
+	UFUNCTION(BlueprintCallable, Category = "Paint")
+		void InvalidateRetainedContent();
+
+	/* Number of deferred groups painted into the window of this widget during the last frame. Content which does not batch is a group of its own. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Paint")
+		int32 GetNumDeferredGroupsPainted() const;
+
 };
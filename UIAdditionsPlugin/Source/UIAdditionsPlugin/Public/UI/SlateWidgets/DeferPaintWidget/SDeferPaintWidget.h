@@ -10,16 +10,47 @@
 #include "Layout/Margin.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Types/SlateEnums.h"
+#include "Widgets/SNullWidget.h"
+
+class SInvalidationPanel;
+struct FDeferPaintWindowState;
 
 
 class UIADDITIONSPLUGIN_API SDeferPaintWidget : public SCompoundWidget {
 
 private:
 
+	// Batching
+
+	/* Group the deferred child with other batched deferred children by DeferredLayer, instead of painting it on a layer of its own. */
+	bool bBatchDeferredPainting = false;
+
+	/* Batched deferred children are painted in ascending order of this layer. Children sharing a layer are painted on the same layers, so they should not overlap. */
+	int32 DeferredLayer = 0;
+
+	/* Batch painter and deferred group count of the window this widget last painted into, shared with the other deferred widgets in it. */
+	mutable TSharedPtr<FDeferPaintWindowState> WindowState = nullptr;
+
+	// Culling
+
+	/* Skip the deferred paint when the child is fully outside of the culling rect of the regular paint. */
+	bool bCullDeferredPainting = true;
+
+	// Retained
+
+	/* The content, which is the child of RetainerPanel while retained. */
+	TSharedRef<SWidget> DeferredContent = SNullWidget::NullWidget;
+
+	/* Caches the draw elements of the content and replays them until the content is invalidated. Valid while retained. */
+	TSharedPtr<SInvalidationPanel> RetainerPanel = nullptr;
+
 protected:
 
 private:
 
+	/* Returns true if the deferred paint of the child would not draw anything: it is collapsed, hidden, fully transparent or (if bCullDeferredPainting) outside MyCullingRect. */
+	bool IsDeferredPaintCulled(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, const FWidgetStyle& InWidgetStyle) const;
+
 protected:
 
 public:
@@ -31,6 +62,10 @@ public:
 		, _HAlign(HAlign_Fill)
 		, _VAlign(VAlign_Fill)
 		, _Padding(FMargin(0.f))
+		, _BatchDeferredPainting(false)
+		, _DeferredLayer(0)
+		, _CullDeferredPainting(true)
+		, _RetainDeferredContent(false)
 	{}
 
 	SLATE_DEFAULT_SLOT(FArguments, Content)
@@ -38,6 +73,10 @@ public:
 	SLATE_ARGUMENT(EHorizontalAlignment, HAlign)
 	SLATE_ARGUMENT(EVerticalAlignment, VAlign)
 	SLATE_ATTRIBUTE(FMargin, Padding)
+	SLATE_ARGUMENT(bool, BatchDeferredPainting)
+	SLATE_ARGUMENT(int32, DeferredLayer)
+	SLATE_ARGUMENT(bool, CullDeferredPainting)
+	SLATE_ARGUMENT(bool, RetainDeferredContent)
 
 	SLATE_END_ARGS()
 
@@ -61,6 +100,40 @@ public:
 
 	void SetPadding(const TAttribute<FMargin>& InPadding);
 
+	// Batching
+
+	bool GetBatchDeferredPainting() const;
+
+	void SetBatchDeferredPainting(bool bInBatchDeferredPainting);
+
+	int32 GetDeferredLayer() const;
+
+	void SetDeferredLayer(int32 InDeferredLayer);
+
+	/* Number of deferred groups painted into the window of this widget during the last frame which painted any. A widget which does not batch is a group of its own. */
+	int32 GetNumDeferredGroupsPainted() const;
+
+	// Culling
+
+	bool GetCullDeferredPainting() const;
+
+	void SetCullDeferredPainting(bool bInCullDeferredPainting);
+
+	// Retained
+
+	bool GetRetainDeferredContent() const;
+
+	/**
+	* While retained, the draw elements of the content are cached and replayed until the content (or anything in it) is invalidated.
+	* The deferred pass then replays the cached elements instead of painting the content again.
+	*/
+	void SetRetainDeferredContent(bool bInRetainDeferredContent);
+
+	/* Forces the retained content to repaint, for changes which do not invalidate the content themselves. */
+	void InvalidateRetainedContent();
+
+	// Paint
+
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 };
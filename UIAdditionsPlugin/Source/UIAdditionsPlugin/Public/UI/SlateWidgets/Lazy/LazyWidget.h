@@ -5,11 +5,14 @@
 #include "Components/ContentWidget.h"
 #include "Layout/Margin.h"
 #include "Widgets/SWidget.h"
+#include "Containers/Ticker.h"
 
 #include "LazyWidget.generated.h"
 
 class UUserWidget;
+class UMenuWidget;
 class SLazyWidget;
+class ULazyWidgetSubsystem;
 class UMaterialInstanceDynamic;
 class UMaterialInterface;
 class USlateBrushAsset;
@@ -25,7 +28,10 @@ in Blueprint besides when you want to show progress in widgets, load icon or tex
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGenericWidgetLazyLoadEvent);
 
 
-/* Wrapper which loads and unloads content to its slot from a soft pointer when requested, when added to a visible UserWidget and when its outer UserWidget broadcasts a change in visibility. */
+/**
+* Wrapper which loads and unloads content to its slot from a soft pointer when requested, when added to a visible UserWidget and when its outer UserWidget broadcasts a change in visibility.
+* Optionally it tracks its visibility relative to all of its ancestors, so content nested deeper than the outer UserWidget is unloaded with the menu, switcher or panel hiding it.
+*/
 UCLASS(meta=(DisplayName="Lazy"))
 class UIADDITIONSPLUGIN_API ULazyWidget : public UContentWidget
 {
@@ -50,10 +56,29 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Setup")
 		bool bLoadControlledBySelfVisibility = true;
 
+	/**
+	* Load / Unload content when the visibility of this widget relative to all of its ancestors changes (see USlateUtils::IsVisibleInHierarchy).
+	* Ancestor menus broadcast their visibility and are acted on immediately. Other ancestors (panels, switchers) are polled at AncestorVisibilityPollInterval.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Setup")
+		bool bLoadControlledByAncestorVisibility = false;
+
+	/* Also unload content scrolled fully out of view of an ancestor ScrollBox. Requires bLoadControlledByAncestorVisibility. */
+	UPROPERTY(EditAnywhere, Category = "Setup", meta = (EditCondition = "bLoadControlledByAncestorVisibility"))
+		bool bLoadControlledByScrollVisibility = false;
+
+	/* Interval in seconds at which ancestors which do not broadcast visibility changes are tested. 0 disables polling, leaving only the menu delegates. */
+	UPROPERTY(EditAnywhere, Category = "Setup", meta = (EditCondition = "bLoadControlledByAncestorVisibility", ClampMin = "0"))
+		float AncestorVisibilityPollInterval = 0.2f;
+
 	/* Slate uses resources for all hidden / removed widgets until they are garbage collected. */
 	UPROPERTY(EditAnywhere, Category = "Setup")
 		bool bCollectGarbageOnUnload = false;
 
+	/* When the lazy content memory budget of the player is exceeded, hidden content with a lower priority is evicted first. */
+	UPROPERTY(EditAnywhere, Category = "Setup")
+		int32 EvictionPriority = 0;
+
 #if WITH_EDITORONLY_DATA
 
 	UPROPERTY(EditAnywhere, Category = "Preview")
@@ -77,8 +102,20 @@ private:
 	UPROPERTY()
 		UUserWidget* OuterUserWidget = nullptr;
 
+	/* Menus between this widget and the root UserWidget, bound to while bLoadControlledByAncestorVisibility. */
+	UPROPERTY()
+		TArray<UMenuWidget*> AncestorMenus;
+
+	/* On the core ticker rather than the world timer manager, which does not tick while the game is paused (pause menus). */
+	FTSTicker::FDelegateHandle AncestorVisibilityPollHandle;
+
+	bool bIsVisibleInHierarchy = false;
+
 	TSharedPtr<FStreamableHandle> StreamingHandle;
 
+	/* Record of the current load in FLazyWidgetTelemetry. */
+	int32 TelemetryRecordIndex = INDEX_NONE;
+
 protected:
 
 	// Lazy
@@ -103,14 +140,33 @@ public:
 
 private:
 
-	/* Private helper to update with loaded content. */
-	void SetLoadedContent(const TSubclassOf<UUserWidget> InContentClass);
+	/* Private helper to update with loaded content. InSyncLoadCounterAtStart is the telemetry sync load counter when loading started, to attribute sync loads to this load. */
+	void SetLoadedContent(const TSubclassOf<UUserWidget> InContentClass, int32 InSyncLoadCounterAtStart);
+
+	/* Returns the subsystem accounting the content of the owning player, if any. */
+	ULazyWidgetSubsystem* GetLazyWidgetSubsystem() const;
+
+	/* Binds to the ancestor menus and starts polling the remaining ancestors. */
+	void StartTrackingAncestorVisibility();
+
+	void StopTrackingAncestorVisibility();
+
+	/* Tells the subsystem the content stopped being visible, which is when it starts aging for eviction. */
+	void MarkContentHidden();
+
+	/* Implements ConditionalLoadOrUnloadContent. InIsVisibleInHierarchy is passed by callers which just computed it, else it is computed if the ancestor visibility controls the load. */
+	void LoadOrUnloadContent(TOptional<bool> InIsVisibleInHierarchy);
 
 	// Delegates
 
 	UFUNCTION()
 		void ActOnOuterVisibilityChanged(ESlateVisibility InVisibility);
 
+	UFUNCTION()
+		void ActOnAncestorMenuVisibilityChanged(UMenuWidget* InMenuWidget, bool bInIsVisible);
+
+	bool ActOnAncestorVisibilityPoll(float InDeltaTime);
+
 protected:
 
 	// Setup
@@ -210,6 +266,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lazy")
 		void SetLoadControlledBySelfVisibility(bool bInLoadControlledBySelfVisibility);
 
+	/* Load / Unload content when the visibility of this widget relative to all of its ancestors changes. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		bool GetLoadControlledByAncestorVisibility() const;
+
+	/* Load / Unload content when the visibility of this widget relative to all of its ancestors changes. */
+	UFUNCTION(BlueprintCallable, Category = "Lazy")
+		void SetLoadControlledByAncestorVisibility(bool bInLoadControlledByAncestorVisibility);
+
+	/* Also unload content scrolled fully out of view of an ancestor ScrollBox. Requires bLoadControlledByAncestorVisibility. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		bool GetLoadControlledByScrollVisibility() const;
+
+	/* Also unload content scrolled fully out of view of an ancestor ScrollBox. Requires bLoadControlledByAncestorVisibility. */
+	UFUNCTION(BlueprintCallable, Category = "Lazy")
+		void SetLoadControlledByScrollVisibility(bool bInLoadControlledByScrollVisibility);
+
 	/* Slate uses resources for all hidden / removed widgets until they are garbage collected. */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
 		bool GetCollectGarbageOnUnload() const;
@@ -218,6 +290,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lazy")
 		void SetCollectGarbageOnUnload(bool bInCollectGarbageOnUnload);
 
+	/* When the lazy content memory budget of the player is exceeded, hidden content with a lower priority is evicted first. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
+		int32 GetEvictionPriority() const;
+
+	/* When the lazy content memory budget of the player is exceeded, hidden content with a lower priority is evicted first. */
+	UFUNCTION(BlueprintCallable, Category = "Lazy")
+		void SetEvictionPriority(int32 InEvictionPriority);
+
+	/* True if any of the visibility conditions controls loading. Without one, content is never reloaded automatically after it is unloaded. */
+	bool IsLoadControlledByVisibility() const;
+
+	/**
+	* True if one of the visibility conditions controlling the load currently sees this widget as hidden (including scrolled out of view, if bLoadControlledByScrollVisibility).
+	* That condition loads the content again once the widget becomes visible, which makes the content safe to evict.
+	* A widget hidden only by an ancestor it does not track (a collapsed panel without bLoadControlledByAncestorVisibility) returns false.
+	*/
+	bool IsHiddenByLoadCondition() const;
+
 	/* Returns a soft pointer to a set class which can be loaded or unloaded on demand. */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lazy")
 		TSoftClassPtr<UUserWidget> GetLazyContent() const;
@@ -32,6 +32,7 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Setup")
         bool bAutoRegisterToParentMenu = true;
 
+    /* The menu this button registered to. Registration happens once per lifetime. */
     UPROPERTY()
         UMenuWidget* RegisteredParentMenu = nullptr;
 
@@ -63,7 +64,7 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
         bool GetAutoRegisterToParentMenu() const;
 
-    /* Configure if this widget should automatically find and register to a parent MenuWidget. The value is processed on OnInitialized and NativeConstruct. */
+    /* Configure if this widget should automatically find and register to a parent MenuWidget. The value is processed on OnInitialized, and on NativeConstruct if no parent menu was found yet. */
     UFUNCTION(BlueprintCallable, Category = "Navigation")
         void SetAutoRegisterToParentMenu(bool bInAutoRegisterToParentMenu);
 
@@ -71,6 +72,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Navigation")
         void RegisterToParentMenu();
 
+    UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+        UMenuWidget* GetRegisteredParentMenu() const;
+
     UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
         FName GetNavigationRoute() const;
 
@@ -0,0 +1,15 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CursorPositioningModes.generated.h"
+
+
+UENUM(BlueprintType)
+enum class E_CursorPositioningModes : uint8 {
+	/* Moves the cursor container through its canvas slot. Invalidates the layout of the canvas every time the cursor moves. */
+	CanvasSlot,
+	/* Moves the cursor container through its render translation. Only invalidates paint, leaving layout of the HUD cached. */
+	RenderTransform,
+};
@@ -5,15 +5,22 @@
 #include "Blueprint/UserWidget.h"
 #include "InputState.h"
 #include "CursorScreenSpace.h"
+#include "CursorPositioningModes.h"
 #include "Layout/Geometry.h"
+#include "ViewportGeometryCache.h"
 
 #include "CursorWidget.generated.h"
 
 
 class UDeferPaintWidget;
 class UCanvasPanel;
+class UGameViewportClient;
+class FSlateUser;
 
 
+/* Native only, TBitArray is not supported by blueprints. Masks are indexed by UCursorWidget::FindOrRegisterCursorContextIndex. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnCursorContextMaskChanged, const TBitArray<>& /* InOldMask */, const TBitArray<>& /* InNewMask */);
+
 /*
 * 
 */
@@ -23,8 +30,16 @@ class UIADDITIONSPLUGIN_API UCursorWidget : public UUserWidget {
 
 private:
 
-	UPROPERTY()
-		TSet<FName> CursorContexts;
+	/* Bit per context, indexed by FindOrRegisterCursorContextIndex. */
+	TBitArray<> CursorContextMask;
+
+	/* Mask at the start of the outermost batch, to compare against on commit. */
+	TBitArray<> CursorContextBatchStartMask;
+
+	int32 CursorContextBatchDepth = 0;
+
+	/* Bound while a batch is open, to commit a batch left open at the end of the frame. */
+	FDelegateHandle CursorContextBatchEndFrameHandle;
 
 	//UPROPERTY(Transient)
 		//E_CursorScreenSpace CursorScreenSpace = E_CursorScreenSpace::PlayerScreen;
@@ -35,9 +50,30 @@ private:
 	UPROPERTY(Transient)
 		FVector2D Position = FVector2D::ZeroVector;
 
+	/* The local position last applied to the cursor container, used to skip positioning when the cursor did not move. */
+	UPROPERTY(Transient)
+		FVector2D LastAppliedLocalPosition = FVector2D::ZeroVector;
+
+	UPROPERTY(Transient)
+		bool bHasAppliedLocalPosition = false;
+
+	// Cached lookups
+
+	/* The owning player the cached Slate user and geometry were resolved for. If the owning player changes, the caches are stale. */
+	TWeakObjectPtr<APlayerController> CachedOwningPlayer = nullptr;
+
+	TWeakPtr<FSlateUser> CachedSlateUser = nullptr;
+
+	/* Geometry of the viewport the cursor is clamped to. */
+	FViewportGeometryCache ViewportGeometryCache;
+
 protected:
 
 	// Setup
+
+	/* How the cursor container is moved to the cursor position. RenderTransform only touches paint and should be preferred when the HUD relies on invalidation, it requires the cursor container slot to be placed at the origin of the canvas. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Cursor")
+		E_CursorPositioningModes CursorPositioningMode = E_CursorPositioningModes::CanvasSlot;
 	
 	/* The canvas serves to offset cursors by a half when required (crosshair centering vs corner pointer etc.) */
 	UPROPERTY(BlueprintReadOnly, Category = "Widgets", meta = (BindWidget))
@@ -45,23 +81,59 @@ protected:
 
 public:
 
+	/* Broadcast once per actual change of the contexts, or once per committed batch which changed them. */
+	FOnCursorContextMaskChanged OnCursorContextMaskChanged;
+
 private:
 
+	/* Global context registry, shared by all cursor widgets so masks are comparable. Game thread only. */
+	static TMap<FName, int32>& GetCursorContextIndices();
+
+	static TArray<FName>& GetCursorContextNames();
+
+	/* Sets a context bit and notifies if it changed, unless a batch is open. */
+	void SetCursorContextBit(int32 InIndex, bool bInValue);
+
+	/* Notifies listeners if the mask differs from InOldMask. */
+	void ConditionalNotifyCursorContextsChanged(const TBitArray<>& InOldMask);
+
+	/* Returns the cached Slate user of the owning player, resolving it again if the owning player changed or the user was removed. */
+	TSharedPtr<FSlateUser> GetSlateUser();
+
+	/* Returns the cached game viewport client. */
+	UGameViewportClient* GetGameViewportClient();
+
+	/* Returns the geometry of the viewport to clamp the cursor to, rebuilding it if it is no longer valid. */
+	const FGeometry& GetViewportGeometry();
+
+	/* Controller ids can change along with the split screen layout, so the Slate user is resolved again. */
+	void ActOnViewportGeometryInvalidated();
+
+	/* Closes the batch and notifies, unbinds the end of frame hook. */
+	void CloseCursorContextBatch();
+
 protected:
 
 	// Setup
 
 	virtual void NativeOnInitialized() override;
 
+	virtual void NativeConstruct() override;
+
+	virtual void NativeDestruct() override;
+
 	// Tick
 
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 	void TickUpdateCursorPosition();
 
+	/* Moves the cursor container to the local position using the current positioning mode. Does nothing if the position did not change since the last call. */
+	void ApplyLocalPosition(const FVector2D& InLocalPosition);
+
 	// Appearance
 
-	/* Implement in blueprints to change the cursor appearance based on cursor contexts. */
+	/* Implement in blueprints to change the cursor appearance based on cursor contexts. Called once per change, or once per committed batch. */
 	UFUNCTION(BlueprintImplementableEvent, Category = "Appearance")
 		void OnCursorContextsChanged();
 
@@ -70,6 +142,9 @@ protected:
 	UFUNCTION()
 		void ActOnInputDeviceChanged(EInputDevices InInputDevice, int32 InSlateUserIndex);
 
+	/* A batch still open at the end of the frame is unbalanced. It is committed so the contexts are not held back. */
+	void ActOnEndFrame();
+
 public:
 
 	// Appearance
@@ -84,6 +159,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Cursor")
 		FVector2D GetPosition() const;
 
+	/* Get how the cursor container is moved to the cursor position. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Cursor")
+		E_CursorPositioningModes GetCursorPositioningMode() const;
+
+	/* Set how the cursor container is moved to the cursor position. Resets the offset applied by the previous mode. */
+	UFUNCTION(BlueprintCallable, Category = "Cursor")
+		void SetCursorPositioningMode(E_CursorPositioningModes InCursorPositioningMode);
+
 	/* Get if the widget freezes to the center of the player screen during TickUpdateCursorPosition. */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Cursor")
 		bool GetFreezeCursorToCenterOfScreen() const;
@@ -92,9 +175,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Cursor")
 		void SetFreezeCursorToCenterOfScreen(bool bInFreezeCursorToCenterOfScreen);
 
-	/* The cursor can be modified based on context, such as opening a certain menu or desiring a crosshair. */
+	/* Forces the Slate user and viewport geometry to be resolved again on the next tick. Resizing the viewport and adding / removing split screen players already does this. */
+	void InvalidateCachedLookups();
+
+	/* Returns the dense index of a context, registering it if new. Indices are shared by all cursor widgets. Resolve once and use HasCursorContextIndex in hot code. */
+	static int32 FindOrRegisterCursorContextIndex(const FName& InContext);
+
+	/* Returns the context name for a registered index, or NAME_None. */
+	static FName GetCursorContextName(int32 InIndex);
+
+	/* The cursor can be modified based on context, such as opening a certain menu or desiring a crosshair. Builds a set from the context mask, prefer HasCursorContext. */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Cursor")
-		const TSet<FName>& GetCursorContexts() const;
+		TSet<FName> GetCursorContexts() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Cursor")
+		bool HasCursorContext(const FName& InContext) const;
+
+	/* Bit test against an index from FindOrRegisterCursorContextIndex. */
+	bool HasCursorContextIndex(int32 InIndex) const;
+
+	const TBitArray<>& GetCursorContextMask() const;
+
+	/* Starts a batch. Context changes made until the matching CommitCursorContextBatch result in a single notification. Batches can be nested.
+	* A batch must be committed within the frame, an open batch is committed with a warning at the end of the frame. From C++ prefer FScopedCursorContextBatch. */
+	UFUNCTION(BlueprintCallable, Category = "Cursor")
+		void BeginCursorContextBatch();
+
+	/* Ends a batch. The outermost commit notifies once if the contexts differ from when the batch began. */
+	UFUNCTION(BlueprintCallable, Category = "Cursor")
+		void CommitCursorContextBatch();
 
 	/* The cursor can be modified based on context, such as opening a certain menu or desiring a crosshair. */
 	UFUNCTION(BlueprintCallable, Category = "Cursor")
@@ -109,3 +218,23 @@ public:
 		void AddOrRemoveCursorContext(const FName& InContext, bool bInAdd);
 
 };
+
+
+/* Opens a cursor context batch on construction and commits it when going out of scope. */
+struct UIADDITIONSPLUGIN_API FScopedCursorContextBatch {
+
+private:
+
+	TWeakObjectPtr<UCursorWidget> CursorWidget = nullptr;
+
+public:
+
+	explicit FScopedCursorContextBatch(UCursorWidget* InCursorWidget);
+
+	~FScopedCursorContextBatch();
+
+	FScopedCursorContextBatch(const FScopedCursorContextBatch&) = delete;
+
+	FScopedCursorContextBatch& operator=(const FScopedCursorContextBatch&) = delete;
+
+};
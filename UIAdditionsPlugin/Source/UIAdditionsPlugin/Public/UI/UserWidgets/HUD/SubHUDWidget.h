@@ -6,6 +6,8 @@
 
 #include "SubHUDWidget.generated.h"
 
+class APawn;
+
 
 /*
 * Managed by the HUD. A "Sub" HUD is the modern widget version of a HUD meant to take over visual tasks.
@@ -17,6 +19,12 @@ class UIADDITIONSPLUGIN_API USubHUDWidget : public UMenuWidget {
 
 private:
 
+	// Pawn
+
+	/* The pawn this sub HUD currently displays, if it is used as a pawn HUD. */
+	UPROPERTY(Transient)
+		TWeakObjectPtr<APawn> BoundPawn = nullptr;
+
 protected:
 
 public:
@@ -35,6 +43,12 @@ protected:
 	UFUNCTION()
 		void ActOnMenuVisibilityChanged(UMenuWidget* InMenuWidget, bool bInIsVisible);
 
+	// Pawn
+
+	/* Called after the sub HUD is bound to a pawn, or unbound with null. Pooled pawn HUDs are reused for other pawns, so rebind any pawn related data here instead of during construction. */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Pawn")
+		void OnBoundToPawn(APawn* InPawn);
+
 public:
 
 	// Setup
@@ -47,4 +61,13 @@ public:
 
 	virtual bool UnRegisterMenu(const FName& InRoute) override;
 
+	// Pawn
+
+	/* Binds this sub HUD to a pawn, or unbinds it with null. Navigation is reset when the pawn changes, so a reused instance does not show menus of the previous pawn. */
+	UFUNCTION(BlueprintCallable, Category = "Pawn")
+		void BindToPawn(APawn* InPawn);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Pawn")
+		APawn* GetBoundPawn() const;
+
 };
\ No newline at end of file
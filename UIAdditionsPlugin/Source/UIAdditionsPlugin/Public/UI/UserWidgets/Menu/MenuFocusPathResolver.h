@@ -0,0 +1,40 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "Templates/SharedPointer.h"
+
+class UMenuWidget;
+class SWidget;
+class FWidgetPath;
+
+
+/* The menu a focus path leads into, resolved once per focus event. */
+struct FMenuFocusPathResolution {
+
+	/* The first menu found walking up from the focused widget. This is the menu the focused widget is directly on. */
+	TWeakObjectPtr<UMenuWidget> InnermostMenu = nullptr;
+
+	/* The focused widget (last widget of the path) this resolution was made for. Weak, so a widget allocated at the address of a destroyed one does not match. */
+	TWeakPtr<SWidget> LastWidget = nullptr;
+
+	int32 PathLength = 0;
+
+	uint64 FrameCounter = 0;
+
+};
+
+/**
+* Resolves a focus path into the innermost menu it contains.
+* Every menu on the screen receives NativeOnFocusChanging for the same focus event, so the result is cached by frame, focused widget and path length.
+* The first menu to receive the event walks the path, the others read the cached result.
+*/
+class UIADDITIONSPLUGIN_API FMenuFocusPathResolver {
+
+public:
+
+	/* Returns the resolution of InPath, walking it only if it was not resolved yet this frame. */
+	static const FMenuFocusPathResolution& Resolve(const FWidgetPath& InPath);
+
+};
@@ -0,0 +1,169 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/TopLevelAssetPath.h"
+
+#include "MenuNavigationGraph.generated.h"
+
+class UMenuWidget;
+
+
+/* A menu class on the navigation graph. */
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_MenuNavigationGraphNode {
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		TSoftClassPtr<UMenuWidget> MenuClass = nullptr;
+
+	/* Routes navigation buttons on this menu request, excluding the NAME_None "go back" route. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		TArray<FName> ButtonRoutes;
+
+};
+
+/* A route registered on a menu, leading to a menu of another class. */
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_MenuNavigationGraphEdge {
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		int32 FromNode = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		FName Route = NAME_None;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		int32 ToNode = INDEX_NONE;
+
+};
+
+/* A route a navigation button requests on a menu, while no menu is registered to it. */
+USTRUCT(BlueprintType)
+struct UIADDITIONSPLUGIN_API FS_MenuNavigationGraphDeadRoute {
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		int32 Node = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+		FName Route = NAME_None;
+
+};
+
+/**
+* Static navigation graph between menu classes, extracted from the menu widget blueprints by the editor (UIAdditionsPluginEditor, MenuNavigationGraph commandlet).
+* Edges are the routes child menus auto register to on their parent menu. Distances and next steps between all menus are precomputed,
+* so reachability, next route and dead route queries are O(1) without constructing any menu.
+* Useful to warm menus the user can reach within a few steps, and to find unreachable, cyclic or dead routes headless.
+*/
+UCLASS(BlueprintType)
+class UIADDITIONSPLUGIN_API UMenuNavigationGraph : public UDataAsset {
+	GENERATED_BODY()
+
+private:
+
+	// Graph
+
+	UPROPERTY(VisibleAnywhere, Category = "Graph")
+		TArray<FS_MenuNavigationGraphNode> Nodes;
+
+	UPROPERTY(VisibleAnywhere, Category = "Graph")
+		TArray<FS_MenuNavigationGraphEdge> Edges;
+
+	UPROPERTY(VisibleAnywhere, Category = "Graph")
+		TArray<FS_MenuNavigationGraphDeadRoute> DeadRoutes;
+
+	/* Nodes which can reach themselves. Registrations are hierarchical, so these indicate a menu class nesting itself. */
+	UPROPERTY(VisibleAnywhere, Category = "Graph")
+		TArray<int32> CyclicNodes;
+
+	/* Nodes × Nodes steps from a node to another. UnreachableDistance if there is no path. */
+	UPROPERTY()
+		TArray<uint8> Distances;
+
+	/* Nodes × Nodes index into Edges of the first step from a node to another. INDEX_NONE if there is no path. */
+	UPROPERTY()
+		TArray<int32> NextEdges;
+
+	// Lookup
+
+	/**
+	* Menu classes are top level assets, so the path is a package and asset name pair which is cheap to build from a class, without a string.
+	* Keyed by path rather than by class pointer, which would go stale when a blueprint class is reinstanced or unloaded.
+	*/
+	TMap<FTopLevelAssetPath, int32> NodeIndicesByPath;
+
+	TSet<TPair<int32, FName>> DeadRouteSet;
+
+protected:
+
+public:
+
+	static const uint8 UnreachableDistance = MAX_uint8;
+
+private:
+
+	// Lookup
+
+	void BuildLookup();
+
+	int32 GetTableIndex(int32 InFromNode, int32 InToNode) const;
+
+protected:
+
+public:
+
+	// Setup
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	/* Replaces the graph and precomputes the distance and next step tables. Called by the editor extraction pass. */
+	void SetGraph(const TArray<FS_MenuNavigationGraphNode>& InNodes, const TArray<FS_MenuNavigationGraphEdge>& InEdges, const TArray<FS_MenuNavigationGraphDeadRoute>& InDeadRoutes);
+#endif // WITH_EDITOR
+
+	// Graph
+
+	const TArray<FS_MenuNavigationGraphNode>& GetNodes() const;
+
+	const TArray<FS_MenuNavigationGraphEdge>& GetEdges() const;
+
+	const TArray<FS_MenuNavigationGraphDeadRoute>& GetDeadRoutes() const;
+
+	const TArray<int32>& GetCyclicNodes() const;
+
+	/* Returns the node of a menu class, or INDEX_NONE if the class is not on the graph. */
+	int32 FindNode(const UClass* InMenuClass) const;
+
+	/* Nodes which no other node leads to, usually the sub HUDs. */
+	TArray<int32> GetRootNodes() const;
+
+	// Queries
+
+	/* Steps from a menu class to another, or UnreachableDistance. */
+	uint8 GetDistance(int32 InFromNode, int32 InToNode) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+		bool IsReachable(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass, int32 InMaxSteps = 255) const;
+
+	/* The route to navigate to on InFromMenuClass, to get one step closer to InToMenuClass. NAME_None if unreachable. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+		FName GetNextRoute(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass) const;
+
+	/* Routes to navigate through from InFromMenuClass to reach InToMenuClass, usable with UMenuWidget::NavigateToRoutePath. Empty if unreachable. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+		TArray<FName> GetRoutePath(TSubclassOf<UMenuWidget> InFromMenuClass, TSubclassOf<UMenuWidget> InToMenuClass) const;
+
+	/* True if a navigation button on InMenuClass requests InRoute while no menu is registered to it. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+		bool IsDeadRoute(TSubclassOf<UMenuWidget> InMenuClass, const FName& InRoute) const;
+
+	/* Menu classes reachable from InFromMenuClass within InMaxSteps, excluding itself. Intended for warming menus ahead of navigation. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
+		TArray<TSoftClassPtr<UMenuWidget>> GetMenusWithinSteps(TSubclassOf<UMenuWidget> InFromMenuClass, int32 InMaxSteps = 1) const;
+
+};
@@ -5,6 +5,7 @@
 #include "Types/SlateEnums.h"
 #include "KeyboundUserWidget.h"
 #include "Templates/SharedPointer.h"
+#include "RoutePathNavigationResults.h"
 
 #include "MenuWidget.generated.h"
 
@@ -25,6 +26,12 @@ UCLASS(Abstract, BlueprintType, Blueprintable, meta = (DontUseGenericSpawnObject
 class UIADDITIONSPLUGIN_API UMenuWidget : public UKeyboundUserWidget {
     GENERATED_BODY()
 
+#if WITH_DEV_AUTOMATION_TESTS
+    friend class FMenuWidgetInitializingParentMenuTest;
+    friend class FMenuWidgetVisibleMenusTest;
+    friend class FMenuWidgetRoutePathTest;
+#endif
+
 private:
 
     // Setup | Navigation
@@ -35,6 +42,17 @@ private:
     UPROPERTY(Transient)
         TMap<FName, UMenuWidget*> Menus;
 
+    /* Reverse index of Menus, so route resolution by menu is a hash lookup. */
+    UPROPERTY(Transient)
+        TMap<UMenuWidget*, FName> MenuRoutes;
+
+    /**
+    * Registered menus which are currently visible, kept up to date through their OnNativeVisibilityChanged, which also covers SetVisibility called directly.
+    * Visibility set on the Slate widget directly bypasses it, so entries are still validated and pruned when read.
+    * Weak, the menus are kept alive through Menus.
+    */
+    mutable TSet<TWeakObjectPtr<UMenuWidget>> VisibleMenus;
+
     UPROPERTY(Transient)
         TArray<UMenuNavigationButtonWidget*> NavigationButtons;
 
@@ -42,6 +60,10 @@ private:
     UPROPERTY(Transient)
         FName ActiveRoute = NAME_None;
 
+    /* Routes of a NavigateToRoutePath which stopped at this menu, because the next menu is in lazy content which is not loaded yet. Navigated once that menu registers. */
+    UPROPERTY(Transient)
+        TArray<FName> PendingRoutePath;
+
 	/* The widget we should attempt to focus when RestoreFocus is called. */
     //UPROPERTY()
         TWeakPtr<SWidget> PreferredFocusEntryWidget = nullptr;
@@ -50,9 +72,12 @@ private:
     UPROPERTY(Transient)
         UMenuWidget* RegisteredParentMenu = nullptr;
 
+    /* The parent menu found through the initialization context. RegisterMenu validates it by the outer chain instead of walking the hierarchy. */
+    TWeakObjectPtr<UMenuWidget> InitializingParentMenu = nullptr;
+
 protected:
 
-    /* Auto register this widget to a Menu ancestor during OnInitialized and Construct. */
+    /* Auto register this widget to a Menu ancestor during OnInitialized, or during Construct if no ancestor was found yet. Registration happens once per lifetime. */
     UPROPERTY(EditAnywhere, Category = "Setup")
         bool bAutoRegisterToParentMenu = true;
 
@@ -80,15 +105,33 @@ private:
 
     // Navigation
 
+    /* Menus which are currently building their widget tree, innermost last. */
+    static TArray<UMenuWidget*, TInlineAllocator<8>>& GetInitializingMenus();
+
+    /* True if InWidget was constructed in the widget tree of InMenu, or in the tree of a user widget nested in it. Walks the outer chain, not the hierarchy. */
+    static bool IsBuiltByMenu(const UWidget* InWidget, const UMenuWidget* InMenu);
+
     /* Private method which sets a descendant menu's parent menu during registration on an ancestor. */
     void SetRegisteredParentMenu(UMenuWidget* InParentMenu);
 
+    /* True if a lazy widget in this menu's widget tree has content set which is not loaded. Menus in that content register once it loads. */
+    bool HasUnloadedLazyContent() const;
+
+    /* Follows InRoutePath from this menu as long as each level is the active route. Returns the deepest menu reached, this menu if none. */
+    UMenuWidget* FindDeepestMenuOnActiveRoutePath(const TArray<FName>& InRoutePath, int32& OutNumLevels) const;
+
+    /* Sets the pressed visualization on every registered navigation button navigating to InRoute. Think of this as an active "tab" button on a navigation bar. */
+    void SetAppearPressedOnButtonsByRoute(const FName& InRoute, bool bInAppearPressed);
+
     // Delegates | Navigation
 
     /* The response to a navigation request of a UMenuWidget. */
     UFUNCTION()
         virtual void ActOnMenuRequestedUINavigation(const FName& InRoute);
 
+    /* Keeps VisibleMenus up to date when the visibility of a registered menu changes. */
+    void ActOnRegisteredMenuVisibilityChanged(ESlateVisibility InVisibility, TWeakObjectPtr<UMenuWidget> InMenuWidget);
+
 protected:
 
     // Setup
@@ -141,6 +184,25 @@ public:
 
     UMenuWidget(const FObjectInitializer& InObjectInitializer);
 
+    /* Pushes this menu as the initialization context while the widget tree is built, so descendant menus and buttons find it without walking up the hierarchy. */
+    virtual bool Initialize() override;
+
+    /**
+    * Returns the innermost menu, other than InWidget, which is currently building its widget tree. Null if there is none.
+    * Widgets initialized as part of a menu's widget tree find their parent menu here without walking up the hierarchy.
+    * Null as well if InWidget was not built by that menu, for example when created during its initialization and added elsewhere.
+    */
+    static UMenuWidget* FindInitializingParentMenu(const UWidget* InWidget);
+
+    /**
+    * Returns the menu InWidget should register to: the initializing parent menu if there is one, else the nearest menu ancestor.
+    * bOutIsInitializingParentMenu is true if it was found through the initialization context.
+    */
+    static UMenuWidget* FindParentMenu(const UWidget* InWidget, bool& bOutIsInitializingParentMenu);
+
+    /* Number of times FindParentMenu had to walk up the hierarchy, since startup. Also reported by STAT_Menu_AncestorWalks. */
+    static uint32 GetNumAncestorWalks();
+
     // Navigation
 
     /* 1. Updates visibility. 2. Calls c++ crucial / exclusive logic. 3. Calls the blueprint event. Do not call your intention is NavigateToRoute on the parent widget. */
@@ -234,12 +296,13 @@ public:
 
     /* Get all registered menu panels. */
     UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
-        TMap<FName, UMenuWidget*> GetMenus() const;
+        const TMap<FName, UMenuWidget*>& GetMenus() const;
 
     /* Get a menu panel registered to this route, or nullptr if there is none. */
     UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
         UMenuWidget* GetMenuByNavigationRoute(const FName& InRoute) const;
 
+    /* True if this menu and at least one of its registered menus is visible. */
     UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Navigation")
         bool IsAnyMenuVisible() const;
 
@@ -263,6 +326,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Navigation")
         UMenuWidget* NavigateToRoute(const FName& InRoute);
 
+    /**
+    * Navigates through multiple levels of registered menus at once, for example Settings -> Controls -> Gamepad.
+    * The full path is validated before anything changes. Levels are applied from the deepest up, so every menu is in its final state before its ancestor becomes visible.
+    * If a level is not registered yet because it lives in unloaded lazy content, the path is applied up to that menu and the rest is navigated once the menu on the next route registers.
+    * Focus is restored once, at the end. Returns the deepest menu the path is active up to (see OutResult), or null if the path is invalid.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+        UMenuWidget* NavigateToRoutePath(const TArray<FName>& InRoutePath, E_RoutePathNavigationResults& OutResult);
+
     /* Register a menu to a route so it can be navigated to using NavigateToRoute. */
     UFUNCTION(BlueprintCallable, Category = "Navigation")
         virtual bool RegisterMenu(UMenuWidget* InMenuWidget, const FName& InRoute);
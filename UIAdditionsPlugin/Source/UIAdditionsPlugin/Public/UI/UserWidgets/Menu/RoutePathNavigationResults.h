@@ -0,0 +1,19 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "RoutePathNavigationResults.generated.h"
+
+
+UENUM(BlueprintType)
+enum class E_RoutePathNavigationResults : uint8 {
+	/* Every level of the path is active. */
+	Navigated,
+	/* The path is active up to a menu whose lazy content is not loaded yet. The rest is navigated once the next menu on the path registers. */
+	Pending,
+	/* A menu changed its route while the path was applied. The path is active up to the returned menu. */
+	Interrupted,
+	/* The path was rejected before anything changed. */
+	Invalid,
+};
@@ -6,6 +6,8 @@
 #include "Templates/SharedPointer.h"
 
 class FDetectCurrentInputDevicePreProcessor;
+class FMultiUserAnalogCursorPreProcessor;
+class FMultiUserFocusChangeDispatcher;
 
 
 class UIADDITIONSPLUGIN_API FUIAdditionsPluginModule : public IModuleInterface {
@@ -14,6 +16,10 @@ private:
 
 	TSharedPtr<FDetectCurrentInputDevicePreProcessor> DetectCurrentInputDevicePreProcessor = nullptr;
 
+	TSharedPtr<FMultiUserAnalogCursorPreProcessor> MultiUserAnalogCursorPreProcessor = nullptr;
+
+	TSharedPtr<FMultiUserFocusChangeDispatcher> MultiUserFocusChangeDispatcher = nullptr;
+
 protected:
 
 public:
@@ -32,4 +38,10 @@ public:
 
 	const TSharedPtr<FDetectCurrentInputDevicePreProcessor>& GetDetectCurrentInputDevicePreProcessor() const;
 
+	/* The single preprocessor all analog cursors (FExtendedAnalogCursor) are added to. */
+	const TSharedPtr<FMultiUserAnalogCursorPreProcessor>& GetMultiUserAnalogCursorPreProcessor() const;
+
+	/* The single subscriber to Slate focus changes, routing them to listeners per Slate user (FMultiUserFocusChangeDispatcher). */
+	const TSharedPtr<FMultiUserFocusChangeDispatcher>& GetMultiUserFocusChangeDispatcher() const;
+
 };
@@ -168,6 +168,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "BPFL|SlateUtils|Widget", meta = (CallableWithoutWorldContext))
 		static bool FindAncestorWidget(const UWidget* InWidget, const UWidget* InAncestorWidget, bool bInLookOutsideUserWidget = true);
 
+	/**
+	* Returns true if InWidget and all of its ancestors (walking out of UserWidgets) are visible (see IsVisible).
+	* A widget which is not the active widget of an ancestor WidgetSwitcher is not visible.
+	* If bInTestScrollRegions, a widget scrolled fully out of view of an ancestor ScrollBox is not visible. This test uses the cached geometry of the last layout pass and passes if that is not available yet.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "BPFL|SlateUtils|Widget", meta = (CallableWithoutWorldContext))
+		static bool IsVisibleInHierarchy(const UWidget* InWidget, bool bInTestScrollRegions = false);
+
 	// Conversion
 
 	/* 
@@ -0,0 +1,76 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/Geometry.h"
+#include "Layout/SlateRect.h"
+#include "Templates/Function.h"
+
+class UGameViewportClient;
+class FViewport;
+
+
+/**
+* Caches a geometry derived from the game viewport (the viewport or a player screen), so it is not looked up every frame.
+* The cache is invalidated when the viewport resizes, when split screen players are added or removed, and when the viewport widget moved or resized (the geometry is absolute).
+* Owners deriving more state from the viewport (a freeze anchor, a Slate user) bind to OnInvalidated.
+* Binds to the viewport events once a game viewport client is cached, and unbinds on Reset.
+*/
+class UIADDITIONSPLUGIN_API FViewportGeometryCache : public FNoncopyable {
+
+private:
+
+	TWeakObjectPtr<UGameViewportClient> CachedGameViewportClient = nullptr;
+
+	FGeometry CachedGeometry = FGeometry();
+
+	/* Absolute rect of the viewport widget when CachedGeometry was stored. */
+	FSlateRect CachedViewportRect = FSlateRect();
+
+	bool bIsGeometryValid = false;
+
+	FDelegateHandle ViewportResizedHandle;
+
+	FDelegateHandle PlayerAddedHandle;
+
+	FDelegateHandle PlayerRemovedHandle;
+
+protected:
+
+public:
+
+	/* Broadcast whenever the cache is invalidated. */
+	FSimpleMulticastDelegate OnInvalidated;
+
+private:
+
+	void ActOnViewportResized(FViewport* InViewport, uint32 InUnused);
+
+	void ActOnPlayerAddedOrRemoved(int32 InPlayerIndex);
+
+protected:
+
+public:
+
+	// Setup
+
+	~FViewportGeometryCache();
+
+	/* Unbinds from the viewport events and forgets the game viewport client. */
+	void Reset();
+
+	// Cache
+
+	/* Returns the game viewport client of the world of InWorldContextObject. Cached and bound to its split screen changes on first use, the world is only resolved while nothing is cached. */
+	UGameViewportClient* GetGameViewportClient(const UObject* InWorldContextObject);
+
+	/* Invalidates the cache if the viewport widget moved or resized since the geometry was cached. GetGeometry does this itself. */
+	void Validate();
+
+	/* Returns the cached geometry, rebuilt through InBuildGeometry if it is no longer valid. */
+	const FGeometry& GetGeometry(TFunctionRef<FGeometry()> InBuildGeometry);
+
+	/* Forces the geometry to be rebuilt on the next GetGeometry, and notifies OnInvalidated. */
+	void Invalidate();
+
+};
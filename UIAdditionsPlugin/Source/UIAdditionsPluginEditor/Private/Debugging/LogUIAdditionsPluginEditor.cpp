@@ -0,0 +1,5 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "LogUIAdditionsPluginEditor.h"
+
+
+DEFINE_LOG_CATEGORY(LogUIAdditionsPluginEditor);
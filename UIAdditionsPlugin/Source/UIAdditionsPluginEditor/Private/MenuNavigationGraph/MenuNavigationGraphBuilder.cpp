@@ -0,0 +1,203 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MenuNavigationGraphBuilder.h"
+#include "MenuNavigationGraph.h"
+#include "MenuWidget.h"
+#include "SubHUDWidget.h"
+#include "MenuNavigationButtonWidget.h"
+#include "LogUIAdditionsPluginEditor.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Engine/Blueprint.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+
+
+// Build
+
+UWidgetTree* FMenuNavigationGraphBuilder::FindWidgetTreeArchetype(UClass* InWidgetClass) {
+	for (UClass* ClassX = InWidgetClass; IsValid(ClassX); ClassX = ClassX->GetSuperClass()) {
+		const UWidgetBlueprintGeneratedClass* GeneratedClassX = Cast<UWidgetBlueprintGeneratedClass>(ClassX);
+		if (!GeneratedClassX) {
+			// Native classes have no designer tree.
+			return nullptr;
+		}
+		UWidgetTree* WidgetTreeX = GeneratedClassX->GetWidgetTreeArchetype();
+		if (IsValid(WidgetTreeX) && IsValid(WidgetTreeX->RootWidget)) {
+			return WidgetTreeX;
+		}
+	}
+	return nullptr;
+}
+
+void FMenuNavigationGraphBuilder::CollectRegistrations(UWidgetTree* InWidgetTree, int32 InDepth, TArray<TPair<UClass*, FName>>& OutChildMenus, TArray<FName>& OutButtonRoutes) const {
+	if (!IsValid(InWidgetTree) || InDepth > MaxUserWidgetDepth) {
+		return;
+	}
+
+	InWidgetTree->ForEachWidget([&](UWidget* InWidgetX) {
+		if (const UMenuWidget* MenuX = Cast<UMenuWidget>(InWidgetX)) {
+			// A menu registers to the nearest menu, which is the menu owning this tree. Its own children are part of its own node.
+			if (MenuX->GetAutoRegisterToParentMenu() && !MenuX->GetAutoRegisterRoute().IsNone()) {
+				OutChildMenus.Add(TPair<UClass*, FName>(MenuX->GetClass(), MenuX->GetAutoRegisterRoute()));
+			}
+		}
+		else if (const UMenuNavigationButtonWidget* ButtonX = Cast<UMenuNavigationButtonWidget>(InWidgetX)) {
+			// NAME_None is the "go back" route and always valid.
+			if (ButtonX->GetAutoRegisterToParentMenu() && !ButtonX->GetNavigationRoute().IsNone()) {
+				OutButtonRoutes.AddUnique(ButtonX->GetNavigationRoute());
+			}
+		}
+		else if (const UUserWidget* UserWidgetX = Cast<UUserWidget>(InWidgetX)) {
+			// Menus and buttons inside a non menu user widget still register to the menu owning this tree.
+			CollectRegistrations(FindWidgetTreeArchetype(UserWidgetX->GetClass()), InDepth + 1, OutChildMenus, OutButtonRoutes);
+		}
+	});
+}
+
+TArray<UClass*> FMenuNavigationGraphBuilder::FindMenuClasses(const TArray<FName>& InPackagePaths) const {
+	TArray<UClass*> MenuClasses;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TArray<FString> PathsToScan;
+	for (const FName& PathX : InPackagePaths) {
+		PathsToScan.Add(PathX.ToString());
+	}
+	AssetRegistry.ScanPathsSynchronous(PathsToScan, false);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackagePaths = InPackagePaths;
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	for (const FAssetData& AssetX : Assets) {
+		// Test the native parent class from the asset tags first, so blueprints which are not menus are never loaded.
+		FString NativeParentClassPath;
+		if (AssetX.GetTagValue(FBlueprintTags::NativeParentClassPath, NativeParentClassPath)) {
+			const UClass* NativeParentClass = FindObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(NativeParentClassPath));
+			if (!IsValid(NativeParentClass) || !NativeParentClass->IsChildOf(UMenuWidget::StaticClass())) {
+				continue;
+			}
+		}
+
+		const UBlueprint* BlueprintX = Cast<UBlueprint>(AssetX.GetAsset());
+		UClass* GeneratedClassX = IsValid(BlueprintX) ? BlueprintX->GeneratedClass.Get() : nullptr;
+		if (IsValid(GeneratedClassX) && GeneratedClassX->IsChildOf(UMenuWidget::StaticClass())) {
+			MenuClasses.Add(GeneratedClassX);
+		}
+	}
+	return MenuClasses;
+}
+
+bool FMenuNavigationGraphBuilder::BuildGraph(UMenuNavigationGraph* InGraph, const TArray<FName>& InPackagePaths) const {
+	if (!IsValid(InGraph)) {
+		UE_LOG(LogUIAdditionsPluginEditor, Error, TEXT("Can't build an invalid menu navigation graph."));
+		return false;
+	}
+
+	TArray<UClass*> MenuClasses = FindMenuClasses(InPackagePaths);
+	if (MenuClasses.Num() == 0) {
+		UE_LOG(LogUIAdditionsPluginEditor, Warning, TEXT("No menu widget blueprints found to build the menu navigation graph from."));
+		return false;
+	}
+
+	TArray<FS_MenuNavigationGraphNode> Nodes;
+	TArray<FS_MenuNavigationGraphEdge> Edges;
+	TArray<FS_MenuNavigationGraphDeadRoute> DeadRoutes;
+	TMap<UClass*, int32> NodeIndices;
+
+	auto FindOrAddNode = [&](UClass* InMenuClass) {
+		if (const int32* ExistingIndex = NodeIndices.Find(InMenuClass)) {
+			return *ExistingIndex;
+		}
+		FS_MenuNavigationGraphNode Node;
+		Node.MenuClass = InMenuClass;
+		const int32 NewIndex = Nodes.Add(Node);
+		NodeIndices.Add(InMenuClass, NewIndex);
+		// Menus found as children are processed too, even if they live outside of the scanned paths.
+		MenuClasses.AddUnique(InMenuClass);
+		return NewIndex;
+	};
+
+	for (int32 i = 0; i < MenuClasses.Num(); i++) {
+		UClass* MenuClassX = MenuClasses[i];
+		const int32 NodeX = FindOrAddNode(MenuClassX);
+
+		TArray<TPair<UClass*, FName>> ChildMenus;
+		TArray<FName> ButtonRoutes;
+		CollectRegistrations(FindWidgetTreeArchetype(MenuClassX), 0, ChildMenus, ButtonRoutes);
+
+		TSet<FName> RegisteredRoutes;
+		for (const TPair<UClass*, FName>& ChildMenuX : ChildMenus) {
+			FS_MenuNavigationGraphEdge Edge;
+			Edge.FromNode = NodeX;
+			Edge.Route = ChildMenuX.Value;
+			Edge.ToNode = FindOrAddNode(ChildMenuX.Key);
+			Edges.Add(Edge);
+			RegisteredRoutes.Add(ChildMenuX.Value);
+		}
+
+		for (const FName& RouteX : ButtonRoutes) {
+			if (!RegisteredRoutes.Contains(RouteX)) {
+				FS_MenuNavigationGraphDeadRoute DeadRoute;
+				DeadRoute.Node = NodeX;
+				DeadRoute.Route = RouteX;
+				DeadRoutes.Add(DeadRoute);
+			}
+		}
+		Nodes[NodeX].ButtonRoutes = MoveTemp(ButtonRoutes);
+	}
+
+	InGraph->SetGraph(Nodes, Edges, DeadRoutes);
+	UE_LOG(LogUIAdditionsPluginEditor, Display, TEXT("Built menu navigation graph %s: %d menus, %d routes, %d dead routes."), *InGraph->GetPathName(), Nodes.Num(), Edges.Num(), DeadRoutes.Num());
+	return true;
+}
+
+int32 FMenuNavigationGraphBuilder::ReportIssues(const UMenuNavigationGraph* InGraph) const {
+	if (!IsValid(InGraph)) {
+		return 0;
+	}
+	int32 NumIssues = 0;
+	const TArray<FS_MenuNavigationGraphNode>& Nodes = InGraph->GetNodes();
+
+	// Sub HUDs are the entry points managed by the HUD. Any other menu should be reachable from one.
+	TArray<int32> EntryNodes;
+	for (int32 i = 0; i < Nodes.Num(); i++) {
+		const UClass* MenuClassX = Nodes[i].MenuClass.Get();
+		if (IsValid(MenuClassX) && MenuClassX->IsChildOf(USubHUDWidget::StaticClass())) {
+			EntryNodes.Add(i);
+		}
+	}
+	if (EntryNodes.Num() == 0) {
+		EntryNodes = InGraph->GetRootNodes();
+	}
+
+	for (int32 ToX = 0; ToX < Nodes.Num(); ToX++) {
+		bool bIsReachable = EntryNodes.Contains(ToX);
+		for (int32 i = 0; !bIsReachable && i < EntryNodes.Num(); i++) {
+			bIsReachable = InGraph->GetDistance(EntryNodes[i], ToX) != UMenuNavigationGraph::UnreachableDistance;
+		}
+		if (!bIsReachable) {
+			UE_LOG(LogUIAdditionsPluginEditor, Warning, TEXT("Unreachable menu: %s is not reachable from any sub HUD."), *Nodes[ToX].MenuClass.ToString());
+			NumIssues++;
+		}
+	}
+
+	for (int32 NodeX : InGraph->GetCyclicNodes()) {
+		UE_LOG(LogUIAdditionsPluginEditor, Warning, TEXT("Cyclic menu: %s can navigate back to itself through registered routes."), *Nodes[NodeX].MenuClass.ToString());
+		NumIssues++;
+	}
+
+	for (const FS_MenuNavigationGraphDeadRoute& DeadRouteX : InGraph->GetDeadRoutes()) {
+		UE_LOG(LogUIAdditionsPluginEditor, Warning, TEXT("Dead route: %s has a navigation button to route %s, but no menu registers to it."), *Nodes[DeadRouteX.Node].MenuClass.ToString(), *DeadRouteX.Route.ToString());
+		NumIssues++;
+	}
+
+	return NumIssues;
+}
@@ -0,0 +1,72 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#include "MenuNavigationGraphCommandlet.h"
+#include "MenuNavigationGraphBuilder.h"
+#include "MenuNavigationGraph.h"
+#include "LogUIAdditionsPluginEditor.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+
+// Setup
+
+UMenuNavigationGraphCommandlet::UMenuNavigationGraphCommandlet() {
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMenuNavigationGraphCommandlet::Main(const FString& InParams) {
+	FString GraphPath;
+	if (!FParse::Value(*InParams, TEXT("Graph="), GraphPath)) {
+		UE_LOG(LogUIAdditionsPluginEditor, Error, TEXT("Missing -Graph=<package path> of the UMenuNavigationGraph asset to build."));
+		return 1;
+	}
+
+	FString PathsValue = TEXT("/Game");
+	FParse::Value(*InParams, TEXT("Paths="), PathsValue);
+	TArray<FString> PathStrings;
+	PathsValue.ParseIntoArray(PathStrings, TEXT("+"));
+	TArray<FName> PackagePaths;
+	for (const FString& PathX : PathStrings) {
+		PackagePaths.Add(FName(*PathX));
+	}
+
+	const bool bSave = !FParse::Param(*InParams, TEXT("NoSave"));
+	const bool bFailOnIssues = FParse::Param(*InParams, TEXT("FailOnIssues"));
+
+	// Load the existing asset, or create it.
+	const FString ObjectPath = FPackageName::IsValidObjectPath(GraphPath) ? GraphPath : GraphPath + TEXT(".") + FPackageName::GetShortName(GraphPath);
+	UMenuNavigationGraph* Graph = LoadObject<UMenuNavigationGraph>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn);
+	if (!IsValid(Graph)) {
+		const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+		UPackage* Package = CreatePackage(*PackageName);
+		Graph = NewObject<UMenuNavigationGraph>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+		FAssetRegistryModule::AssetCreated(Graph);
+		UE_LOG(LogUIAdditionsPluginEditor, Display, TEXT("Created menu navigation graph: %s"), *Graph->GetPathName());
+	}
+
+	const FMenuNavigationGraphBuilder Builder;
+	if (!Builder.BuildGraph(Graph, PackagePaths)) {
+		return 1;
+	}
+	const int32 NumIssues = Builder.ReportIssues(Graph);
+	UE_LOG(LogUIAdditionsPluginEditor, Display, TEXT("Menu navigation graph issues: %d"), NumIssues);
+
+	if (bSave) {
+		UPackage* Package = Graph->GetPackage();
+		Package->MarkPackageDirty();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		if (!UPackage::SavePackage(Package, Graph, *Filename, SaveArgs)) {
+			UE_LOG(LogUIAdditionsPluginEditor, Error, TEXT("Failed to save the menu navigation graph: %s"), *Filename);
+			return 1;
+		}
+	}
+
+	return (bFailOnIssues && NumIssues > 0) ? 2 : 0;
+}
@@ -0,0 +1,7 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+DECLARE_LOG_CATEGORY_EXTERN(LogUIAdditionsPluginEditor, Log, All);
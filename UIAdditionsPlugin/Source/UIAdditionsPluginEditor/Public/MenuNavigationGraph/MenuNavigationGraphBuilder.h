@@ -0,0 +1,50 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMenuNavigationGraph;
+class UWidgetTree;
+
+
+/**
+* Extracts the static navigation graph between menu classes from the menu widget blueprints.
+* A child menu in a menu's widget tree which auto registers to its parent menu becomes an edge on its auto register route.
+* Navigation button routes without a menu registered to them become dead routes.
+* Menus registered manually at runtime (RegisterMenu) are not visible to the extraction.
+*/
+class FMenuNavigationGraphBuilder {
+	
+private:
+
+	/* Max depth of non menu user widgets to look through for menus and buttons registering to the outer menu. */
+	static const int32 MaxUserWidgetDepth = 8;
+
+protected:
+
+public:
+
+private:
+
+	/* Finds the widget tree archetype of a widget blueprint class, or of the first parent class which has one. */
+	static UWidgetTree* FindWidgetTreeArchetype(UClass* InWidgetClass);
+
+	/* Collects the menus and navigation buttons in InWidgetTree which register to the menu owning the tree. */
+	void CollectRegistrations(UWidgetTree* InWidgetTree, int32 InDepth, TArray<TPair<UClass*, FName>>& OutChildMenus, TArray<FName>& OutButtonRoutes) const;
+
+	/* Finds the menu widget classes in blueprints below InPackagePaths, without loading blueprints which are not menus. */
+	TArray<UClass*> FindMenuClasses(const TArray<FName>& InPackagePaths) const;
+
+protected:
+
+public:
+	
+	// Build
+
+	/* Extracts the graph from the menus below InPackagePaths and stores it on InGraph. Returns false if nothing could be extracted. */
+	bool BuildGraph(UMenuNavigationGraph* InGraph, const TArray<FName>& InPackagePaths) const;
+
+	/* Logs unreachable menus (not reachable from any sub HUD), cyclic menus and dead routes. Returns the number of issues. */
+	int32 ReportIssues(const UMenuNavigationGraph* InGraph) const;
+
+};
@@ -0,0 +1,37 @@
+/**Copyright 2025: Roy Wierer (Ferrefy). All Rights Reserved.**/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "MenuNavigationGraphCommandlet.generated.h"
+
+
+/**
+* Rebuilds a UMenuNavigationGraph asset from the menu widget blueprints and reports unreachable menus, cyclic menus and dead routes.
+* Usage: UnrealEditor-Cmd.exe <Project> -run=MenuNavigationGraph -Graph=/Game/UI/MenuNavigationGraph [-Paths=/Game+/UIAdditionsPlugin] [-NoSave] [-FailOnIssues]
+* Returns non zero on failure, or when issues were found and -FailOnIssues is passed, so it can run headless in automation.
+*/
+UCLASS()
+class UIADDITIONSPLUGINEDITOR_API UMenuNavigationGraphCommandlet : public UCommandlet {
+	GENERATED_BODY()
+
+private:
+
+protected:
+
+public:
+
+private:
+
+protected:
+
+public:
+
+	// Setup
+
+	UMenuNavigationGraphCommandlet();
+
+	virtual int32 Main(const FString& InParams) override;
+
+};
@@ -18,6 +18,8 @@ public class UIAdditionsPluginEditor : ModuleRules {
 		
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"UnrealEd"
+			, "UMG"
+			, "AssetRegistry"
 		});
 
 		PublicDependencyModuleNames.AddRange(new string[] {